@@ -0,0 +1,132 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+/* contention benchmark of the small objects allocator: every thread
+   allocates and frees batches of small blocks with SCE_Mem_RawAlloc(), the
+   same run is done with malloc() for reference. The number of threads goes
+   from 1 to the one given on the command line.
+
+   usage: membench [max threads] [operations per thread] */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <SCE/utils/SCEUtils.h>
+
+#define BATCH 32                /* blocks held at once by a thread */
+
+typedef struct {
+    int use_sce;
+    unsigned long n_ops;
+} bench_args;
+
+static void* run (void *data)
+{
+    const bench_args *args = data;
+    void *blocks[BATCH];
+    unsigned long i;
+    size_t j;
+
+    for (i = 0; i < args->n_ops; i += BATCH) {
+        for (j = 0; j < BATCH; j++) {
+            /* spread over several size classes */
+            size_t size = 8 + (j * 24) % SCE_MEM_SMALL_SIZE;
+            blocks[j] = args->use_sce ? SCE_Mem_RawAlloc (size) :
+                malloc (size);
+            *(volatile char*)blocks[j] = 0;
+        }
+        for (j = 0; j < BATCH; j++) {
+            if (args->use_sce)
+                SCE_Mem_RawFree (blocks[j]);
+            else
+                free (blocks[j]);
+        }
+    }
+    return NULL;
+}
+
+static double now (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* returns the time of one allocation and free in nanoseconds, measured on
+   the wall clock so that waiting on locks counts */
+static double bench (int n_threads, int use_sce, unsigned long n_ops)
+{
+    pthread_t *threads = NULL;
+    bench_args args;
+    double start;
+    int i;
+
+    if (!(threads = malloc (n_threads * sizeof *threads))) {
+        perror ("malloc");
+        exit (EXIT_FAILURE);
+    }
+    args.use_sce = use_sce;
+    args.n_ops = n_ops;
+    start = now ();
+    for (i = 0; i < n_threads; i++) {
+        if (pthread_create (&threads[i], NULL, run, &args)) {
+            fprintf (stderr, "membench: failed to create a thread\n");
+            exit (EXIT_FAILURE);
+        }
+    }
+    for (i = 0; i < n_threads; i++)
+        pthread_join (threads[i], NULL);
+    free (threads);
+
+    return (now () - start) * 1e9 / ((double)n_ops * n_threads);
+}
+
+int main (int argc, char **argv)
+{
+    int max_threads = 4, i;
+    unsigned long n_ops = 1000000;
+
+    if (argc > 1)
+        max_threads = atoi (argv[1]);
+    if (argc > 2)
+        n_ops = strtoul (argv[2], NULL, 10);
+    if (max_threads < 1 || n_ops < BATCH) {
+        fprintf (stderr, "usage: %s [max threads] [operations per thread]\n",
+                 argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (SCE_Init_Utils (stderr) < 0) {
+        SCEE_Out ();
+        return EXIT_FAILURE;
+    }
+
+    printf ("threads  SCE_Mem_RawAlloc  malloc   (ns per alloc+free)\n");
+    for (i = 1; i <= max_threads; i++) {
+        double sce = bench (i, SCE_TRUE, n_ops);
+        double libc = bench (i, SCE_FALSE, n_ops);
+        printf ("%7d  %16.1f  %6.1f\n", i, sce, libc);
+    }
+
+    SCE_Quit_Utils ();
+    return EXIT_SUCCESS;
+}
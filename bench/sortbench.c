@@ -0,0 +1,148 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+/* benchmark of the list sorts: SCE_List_MergeSort() against
+   SCE_List_GnomeSort() and SCE_List_QuickSort() on sorted, reversed and
+   random lists of growing sizes. The last two are quadratic and only run
+   up to a smaller size, deep recursions of the quick sort would overflow
+   the stack on big sorted lists anyway.
+
+   usage: sortbench [max elements] [max elements of the quadratic sorts] */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <SCE/utils/SCEUtils.h>
+
+typedef void (*sort_func) (SCE_SList*, SCE_FListCompareData);
+
+static int compare (const void *a, const void *b)
+{
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static double now (void)
+{
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* fills the list with \p n elements in the given order: 0 sorted,
+   1 reversed, 2 random */
+static void fill (SCE_SList *l, SCE_SListIterator *its, int *values,
+                  unsigned long n, int order)
+{
+    unsigned long i;
+
+    SCE_List_Init (l);
+    SCE_List_CanDeleteIterators (l, SCE_FALSE);
+    srand (42);
+    for (i = 0; i < n; i++) {
+        switch (order) {
+        case 0: values[i] = i; break;
+        case 1: values[i] = n - i; break;
+        default: values[i] = rand ();
+        }
+        SCE_List_InitIt (&its[i]);
+        SCE_List_SetData (&its[i], &values[i]);
+        SCE_List_Appendl (l, &its[i]);
+    }
+}
+
+/* returns the time taken by \p sort in milliseconds */
+static double bench (sort_func sort, SCE_SListIterator *its, int *values,
+                     unsigned long n, int order)
+{
+    SCE_SList l;
+    SCE_SListIterator *it = NULL;
+    const int *prev = NULL;
+    double start, t;
+
+    fill (&l, its, values, n, order);
+    start = now ();
+    sort (&l, compare);
+    t = (now () - start) * 1e3;
+
+    SCE_List_ForEach (it, &l) {
+        if (prev && compare (prev, SCE_List_GetData (it)) > 0) {
+            fprintf (stderr, "sortbench: list not sorted\n");
+            exit (EXIT_FAILURE);
+        }
+        prev = SCE_List_GetData (it);
+    }
+    if (SCE_List_GetLength (&l) != n) {
+        fprintf (stderr, "sortbench: elements lost by the sort\n");
+        exit (EXIT_FAILURE);
+    }
+    return t;
+}
+
+int main (int argc, char **argv)
+{
+    static const char *orders[] = {"sorted", "reverse", "random"};
+    unsigned long max_n = 1000000, max_quadratic = 10000, n;
+    SCE_SListIterator *its = NULL;
+    int *values = NULL;
+    int order;
+
+    if (argc > 1)
+        max_n = strtoul (argv[1], NULL, 10);
+    if (argc > 2)
+        max_quadratic = strtoul (argv[2], NULL, 10);
+    if (!max_n) {
+        fprintf (stderr, "usage: %s [max elements] [max elements of the "
+                 "quadratic sorts]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    its = malloc (max_n * sizeof *its);
+    values = malloc (max_n * sizeof *values);
+    if (!its || !values) {
+        perror ("malloc");
+        return EXIT_FAILURE;
+    }
+    if (SCE_Init_Utils (stderr) < 0) {
+        SCEE_Out ();
+        return EXIT_FAILURE;
+    }
+
+    printf ("order    elements  merge (ms)  gnome (ms)  quick (ms)\n");
+    for (order = 0; order < 3; order++) {
+        for (n = 1000; n <= max_n; n *= 10) {
+            printf ("%-7s  %8lu  %10.2f", orders[order], n,
+                    bench (SCE_List_MergeSort, its, values, n, order));
+            if (n <= max_quadratic) {
+                printf ("  %10.2f", bench (SCE_List_GnomeSort, its, values,
+                                           n, order));
+                printf ("  %10.2f\n", bench (SCE_List_QuickSort, its, values,
+                                             n, order));
+            } else
+                printf ("  %10s  %10s\n", "-", "-");
+        }
+    }
+
+    SCE_Quit_Utils ();
+    free (values);
+    free (its);
+    return EXIT_SUCCESS;
+}
@@ -27,6 +27,11 @@ AC_DEFUN([SCE_CHECK_DEBUG],
                                  [enable debugging @<:@default=yes@:>@]),
                   [enable_debug="$enableval"],
                   [enable_debug="yes"])
+    AC_ARG_ENABLE([memory_stats],
+                  AS_HELP_STRING([--enable-memory-stats],
+                                 [keep memory allocation statistics even without debugging @<:@default=no@:>@]),
+                  [enable_memory_stats="$enableval"],
+                  [enable_memory_stats="no"])
 
     SCE_DEBUG_CFLAGS=
     SCE_DEBUG_CFLAGS_EXPORT=
@@ -42,6 +47,16 @@ AC_DEFUN([SCE_CHECK_DEBUG],
            AC_MSG_RESULT([no])])
     AC_SUBST([DEBUG_CFLAGS])
 
+    dnl memory statistics (always kept when debugging)
+    AC_MSG_CHECKING([whether to keep memory allocation statistics])
+    AS_IF([test "x$enable_memory_stats" = "xyes"],
+          [AC_DEFINE([SCE_MEM_STATS], [1], [are memory statistics kept])
+           SCE_DEBUG_CFLAGS_EXPORT="$SCE_DEBUG_CFLAGS_EXPORT -DSCE_MEM_STATS"
+           AC_MSG_RESULT([yes])],
+          [AS_IF([test "x$enable_debug" = "xyes"],
+                 [AC_MSG_RESULT([yes (debugging)])],
+                 [AC_MSG_RESULT([no])])])
+
     dnl stack debugging
     AC_MSG_CHECKING([whether to enable stack debugging])
     AS_IF([test "x$enable_debug_stack" = "xyes"],
@@ -0,0 +1,84 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEARENA_H
+#define SCEARENA_H
+
+#include <stddef.h>
+#include "SCE/utils/SCEMacros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Default size of the chunks of an arena, in bytes */
+#define SCE_ARENA_DEFAULT_CHUNK_SIZE 16384
+/** \brief Alignment of every pointer returned by an arena */
+#define SCE_ARENA_ALIGNMENT 16
+
+typedef struct sce_sarenachunk SCE_SArenaChunk;
+
+typedef struct sce_sarena SCE_SArena;
+struct sce_sarena {
+    SCE_SArenaChunk *first;     /* chain of chunks */
+    SCE_SArenaChunk *current;   /* chunk allocations are taken from */
+    size_t chunk_size;          /* minimum size of a new chunk */
+    int growable;               /* can more than one chunk be allocated */
+};
+
+/**
+ * \brief Position in an arena, to rewind to
+ * \sa SCE_Arena_Mark(), SCE_Arena_Rewind()
+ */
+typedef struct sce_sarenamark SCE_SArenaMark;
+struct sce_sarenamark {
+    SCE_SArenaChunk *chunk;
+    size_t offset;
+};
+
+void SCE_Arena_Init (SCE_SArena*);
+void SCE_Arena_Clear (SCE_SArena*);
+
+void SCE_Arena_SetChunkSize (SCE_SArena*, size_t);
+void SCE_Arena_SetGrowable (SCE_SArena*, int);
+int SCE_Arena_Reserve (SCE_SArena*, size_t);
+
+void* SCE_Arena_Alloc (SCE_SArena*, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (2);
+void* SCE_Arena_Calloc (SCE_SArena*, size_t, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE2 (2, 3);
+void* SCE_Arena_Dup (SCE_SArena*, const void*, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (3);
+
+void SCE_Arena_Mark (const SCE_SArena*, SCE_SArenaMark*);
+void SCE_Arena_Rewind (SCE_SArena*, const SCE_SArenaMark*);
+void SCE_Arena_Reset (SCE_SArena*);
+
+size_t SCE_Arena_GetUsedSize (const SCE_SArena*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
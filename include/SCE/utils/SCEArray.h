@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 17/05/2012
-   updated: 17/05/2012 */
+   updated: 17/10/2026 */
 
 #ifndef SCEARRAY_H
 #define SCEARRAY_H
@@ -26,18 +26,36 @@
 extern "C" {
 #endif
 
+/** \brief Default growth factor of the arrays */
+#define SCE_ARRAY_DEFAULT_GROWTH 2.0f
+/** \brief Smallest storage allocated by an array, in bytes */
+#define SCE_ARRAY_MIN_CAPACITY 16
+
 typedef struct sce_sarray SCE_SArray;
 struct sce_sarray {
     unsigned char *ptr;
-    size_t removed_front, removed_back;
-    size_t size;
+    size_t removed_front;       /* bytes removed from the front */
+    size_t size;                /* used bytes of ptr, removed ones included */
     size_t allocated;
+    size_t reserved;            /* storage kept by SCE_Array_Reserve() */
+    float growth;               /* growth factor of the storage */
+    size_t alignment;           /* alignment of ptr, 0 for SCE_malloc()'s */
 };
 
 void SCE_Array_Init (SCE_SArray*);
 void SCE_Array_Clear (SCE_SArray*);
 
+void SCE_Array_SetAlignment (SCE_SArray*, size_t);
+void SCE_Array_SetGrowthFactor (SCE_SArray*, float);
+
+int SCE_Array_Reserve (SCE_SArray*, size_t);
+int SCE_Array_ShrinkToFit (SCE_SArray*);
+size_t SCE_Array_GetCapacity (const SCE_SArray*);
+
 int SCE_Array_Append (SCE_SArray*, void*, size_t);
+void* SCE_Array_AppendUninit (SCE_SArray*, size_t);
+void SCE_Array_Adopt (SCE_SArray*, void*, size_t, size_t);
+void* SCE_Array_Detach (SCE_SArray*, size_t*);
 int SCE_Array_PopFront (SCE_SArray*, size_t);
 int SCE_Array_PopBack (SCE_SArray*, size_t);
 void* SCE_Array_Get (const SCE_SArray*);
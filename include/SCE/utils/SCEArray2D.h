@@ -17,15 +17,23 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 14/06/2013
-   updated: 14/06/2013 */
+   updated: 17/10/2026 */
 
 #ifndef SCEARRAY2D_H
 #define SCEARRAY2D_H
 
+#include <stddef.h>
+#include "SCE/utils/SCERectangle.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** \brief Default log2 of the side of the tiles of a tiled 2D array */
+#define SCE_ARRAY2D_DEFAULT_TILE_SHIFT 5
+
+typedef struct sce_sarrayblock SCE_SArray2DTile;
+
 typedef struct sce_sarray2d SCE_SArray2D;
 struct sce_sarray2d {
     char *ptr;
@@ -33,6 +41,13 @@ struct sce_sarray2d {
     size_t size;                /* size of each element (default is 1) */
     size_t w, h;                /* allocated size */
     size_t x, y;                /* coordinates (offset) of the origin (0,0) */
+    size_t alignment;           /* alignment of ptr, 0 for SCE_malloc()'s */
+    /* tiled storage, see SCE_Array2D_SetTiled() */
+    unsigned int tile_shift;    /* log2 of the side of a tile, 0 if dense */
+    SCE_SArray2DTile **tiles;   /* hash table of the allocated tiles */
+    size_t n_tiles, tiles_size;
+    long min_x, min_y;          /* bounding box of the elements set */
+    long max_x, max_y;
 };
 
 void SCE_Array2D_Init (SCE_SArray2D*);
@@ -40,10 +55,20 @@ void SCE_Array2D_Clear (SCE_SArray2D*);
 
 void SCE_Array2D_SetElementSize (SCE_SArray2D*, size_t);
 int SCE_Array2D_SetEmptyPattern (SCE_SArray2D*, const void*);
+void SCE_Array2D_SetAlignment (SCE_SArray2D*, size_t);
+void SCE_Array2D_SetTiled (SCE_SArray2D*, unsigned int);
+size_t SCE_Array2D_GetNumTiles (const SCE_SArray2D*);
+int SCE_Array2D_Reserve (SCE_SArray2D*, const SCE_SIntRect*);
 
 int SCE_Array2D_Set (SCE_SArray2D*, long, long, void*);
 int SCE_Array2D_Get (SCE_SArray2D*, long, long, void*);
 
+int SCE_Array2D_SetRow (SCE_SArray2D*, long, long, size_t, const void*);
+int SCE_Array2D_GetRow (SCE_SArray2D*, long, long, size_t, void*);
+int SCE_Array2D_SetRect (SCE_SArray2D*, const SCE_SIntRect*, const void*);
+int SCE_Array2D_GetRect (SCE_SArray2D*, const SCE_SIntRect*, void*);
+int SCE_Array2D_FillRect (SCE_SArray2D*, const SCE_SIntRect*, const void*);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,87 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEARRAY3D_H
+#define SCEARRAY3D_H
+
+#include <stddef.h>
+#include "SCE/utils/SCERectangle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Default log2 of the side of the bricks of a 3D array */
+#define SCE_ARRAY3D_DEFAULT_BRICK_SHIFT 4
+
+typedef struct sce_sarrayblock SCE_SArray3DBrick;
+
+typedef struct sce_sarray3d SCE_SArray3D;
+struct sce_sarray3d {
+    void *empty_pattern;
+    size_t size;                /* size of each element (default is 1) */
+    size_t alignment;           /* alignment of the bricks, 0 for SCE_malloc */
+    unsigned int brick_shift;   /* log2 of the side of a brick */
+    SCE_SArray3DBrick **bricks; /* hash table of the allocated bricks */
+    size_t n_bricks, bricks_size;
+    SCE_SArray3DBrick *first;   /* chain of all the bricks */
+    long min[3], max[3];        /* bounding box of the elements set */
+};
+
+void SCE_Array3D_Init (SCE_SArray3D*);
+void SCE_Array3D_Clear (SCE_SArray3D*);
+
+void SCE_Array3D_SetElementSize (SCE_SArray3D*, size_t);
+int SCE_Array3D_SetEmptyPattern (SCE_SArray3D*, const void*);
+void SCE_Array3D_SetAlignment (SCE_SArray3D*, size_t);
+void SCE_Array3D_SetBrickShift (SCE_SArray3D*, unsigned int);
+
+size_t SCE_Array3D_GetNumBricks (const SCE_SArray3D*);
+int SCE_Array3D_GetBounds (const SCE_SArray3D*, SCE_SLongRect3*);
+
+int SCE_Array3D_Set (SCE_SArray3D*, long, long, long, const void*);
+int SCE_Array3D_Get (SCE_SArray3D*, long, long, long, void*);
+
+int SCE_Array3D_SetRegion (SCE_SArray3D*, const SCE_SLongRect3*, const void*);
+int SCE_Array3D_GetRegion (SCE_SArray3D*, const SCE_SLongRect3*, void*);
+int SCE_Array3D_FillRegion (SCE_SArray3D*, const SCE_SLongRect3*,
+                            const void*);
+
+SCE_SArray3DBrick* SCE_Array3D_GetFirstBrick (SCE_SArray3D*);
+SCE_SArray3DBrick* SCE_Array3D_GetNextBrick (SCE_SArray3DBrick*);
+void SCE_Array3D_GetBrickRegion (const SCE_SArray3D*, const SCE_SArray3DBrick*,
+                                 SCE_SLongRect3*);
+void* SCE_Array3D_GetBrickData (SCE_SArray3DBrick*);
+
+/**
+ * \brief Iterates over the allocated bricks of a 3D array
+ * \param b a SCE_SArray3DBrick pointer
+ * \param a the array
+ */
+#define SCE_Array3D_ForEachBrick(b, a)\
+    for ((b) = SCE_Array3D_GetFirstBrick (a); (b);\
+         (b) = SCE_Array3D_GetNextBrick (b))
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,49 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEATOMICLIST_H
+#define SCEATOMICLIST_H
+
+#include "SCE/utils/SCEList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sce_satomiclist SCE_SAtomicList;
+struct sce_satomiclist {
+    SCE_SListIterator *head;    /* last pushed node, written by producers */
+    SCE_SListIterator *tail;    /* next node to pop, owned by the consumer */
+    SCE_SListIterator stub;     /* keeps the queue never empty */
+};
+
+void SCE_AtomicList_Init (SCE_SAtomicList*);
+
+void SCE_AtomicList_Push (SCE_SAtomicList*, SCE_SListIterator*);
+SCE_SListIterator* SCE_AtomicList_Pop (SCE_SAtomicList*);
+unsigned int SCE_AtomicList_PopAll (SCE_SAtomicList*, SCE_SList*);
+int SCE_AtomicList_IsEmpty (const SCE_SAtomicList*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
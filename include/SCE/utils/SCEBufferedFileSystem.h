@@ -0,0 +1,53 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEBUFFEREDFILESYSTEM_H
+#define SCEBUFFEREDFILESYSTEM_H
+
+#include <stddef.h>
+#include "SCE/utils/SCEFile.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Default size of the buffer of a file, in bytes */
+#define SCE_BUFFEREDFS_DEFAULT_BUFFER_SIZE 8192
+
+extern SCE_SFileSystem sce_buffs;
+
+int SCE_Init_BufferedFS (void);
+void SCE_Quit_BufferedFS (void);
+
+void SCE_BufferedFS_SetDefaultBufferSize (size_t);
+size_t SCE_BufferedFS_GetDefaultBufferSize (void);
+
+int SCE_BufferedFS_SetBufferSize (SCE_SFile*, size_t);
+size_t SCE_BufferedFS_GetBufferSize (SCE_SFile*);
+
+size_t SCE_BufferedFS_Peek (SCE_SFile*, void*, size_t);
+int SCE_BufferedFS_Unread (SCE_SFile*, size_t);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,94 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEDYNVECTOR_H
+#define SCEDYNVECTOR_H
+
+#include <stddef.h>
+#include "SCE/utils/SCEThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Smallest number of elements allocated by a vector */
+#define SCE_VECTOR_MIN_CAPACITY 8
+
+typedef void (*SCE_FVectorForEach)(void*, void*);
+
+typedef struct sce_svector SCE_SVector;
+struct sce_svector {
+    unsigned char *data;
+    size_t elt_size;            /* size of an element, in bytes */
+    size_t n;                   /* number of elements */
+    size_t capacity;            /* number of allocated elements */
+};
+
+void SCE_Vector_Init (SCE_SVector*);
+void SCE_Vector_Clear (SCE_SVector*);
+void SCE_Vector_Flush (SCE_SVector*);
+
+void SCE_Vector_SetElementSize (SCE_SVector*, size_t);
+
+int SCE_Vector_Reserve (SCE_SVector*, size_t);
+int SCE_Vector_ShrinkToFit (SCE_SVector*);
+size_t SCE_Vector_GetCapacity (const SCE_SVector*);
+
+int SCE_Vector_Append (SCE_SVector*, const void*);
+int SCE_Vector_AppendPtr (SCE_SVector*, void*);
+void SCE_Vector_Remove (SCE_SVector*, size_t);
+void SCE_Vector_SwapRemove (SCE_SVector*, size_t);
+void SCE_Vector_PopBack (SCE_SVector*);
+
+void* SCE_Vector_Get (const SCE_SVector*, size_t);
+void* SCE_Vector_GetPtr (const SCE_SVector*, size_t);
+void SCE_Vector_Set (SCE_SVector*, size_t, const void*);
+size_t SCE_Vector_GetLength (const SCE_SVector*);
+long SCE_Vector_LocatePtr (const SCE_SVector*, const void*);
+
+int SCE_Vector_ParallelForEach (SCE_SThreadPool*, SCE_SVector*, unsigned int,
+                                SCE_FVectorForEach, void**);
+
+/**
+ * \brief Gets the element \p i of a vector, without function call
+ * \param type type of the elements
+ */
+#define SCE_Vector_At(v, type, i) (((type*)(v)->data)[i])
+
+/**
+ * \brief Iterates over the elements of a vector
+ * \param it a pointer to the type of the elements, pointing to the current
+ * element in the loop
+ * \param v the vector
+ *
+ * The vector must not grow during the loop.
+ * \sa SCE_List_ForEach()
+ */
+#define SCE_Vector_ForEach(it, v)\
+    for ((it) = (void*)(v)->data;\
+         (unsigned char*)(it) < (v)->data + (v)->n * (v)->elt_size;\
+         (it)++)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
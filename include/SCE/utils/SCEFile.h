@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 09/08/2012
-   updated: 19/08/2012 */
+   updated: 17/10/2026 */
 
 #ifndef SCEFILE_H
 #define SCEFILE_H
@@ -34,6 +34,16 @@ extern "C" {
 typedef struct sce_sfile SCE_SFile;
 typedef struct sce_sfilesystem SCE_SFileSystem;
 
+/**
+ * \brief Buffer of a vectored read or write
+ * \sa SCE_File_ReadV(), SCE_File_WriteV()
+ */
+typedef struct sce_sfileiovec SCE_SFileIOVec;
+struct sce_sfileiovec {
+    void *data;
+    size_t size;                /* in bytes */
+};
+
 typedef int (*SCE_FInitFunc)(SCE_SFileSystem*, SCE_SFile*);
 typedef void* (*SCE_FOpenFunc)(SCE_SFileSystem*, const char*, int);
 typedef int (*SCE_FCloseFunc)(void*);
@@ -45,6 +55,12 @@ typedef void (*SCE_FRewindFunc)(void*);
 typedef int (*SCE_FFlushFunc)(void*);
 typedef int (*SCE_FTruncateFunc)(SCE_SFile*, size_t);
 typedef size_t (*SCE_FLengthFunc)(const void*);
+typedef const void* (*SCE_FMapFunc)(void*, size_t*);
+typedef size_t (*SCE_FPReadFunc)(void*, size_t, size_t, long, void*);
+typedef size_t (*SCE_FPWriteFunc)(const void*, size_t, size_t, long, void*);
+typedef size_t (*SCE_FReadVFunc)(const SCE_SFileIOVec*, size_t, void*);
+typedef size_t (*SCE_FWriteVFunc)(const SCE_SFileIOVec*, size_t, void*);
+typedef void (*SCE_FUnmapFunc)(void*, const void*, size_t);
 
 struct sce_sfilesystem {
     void *udata;
@@ -60,6 +76,12 @@ struct sce_sfilesystem {
     SCE_FFlushFunc xflush;
     SCE_FTruncateFunc xtruncate;
     SCE_FLengthFunc xlength;
+    SCE_FMapFunc xmap;          /* optional, see SCE_File_Map() */
+    SCE_FUnmapFunc xunmap;
+    SCE_FPReadFunc xpread;      /* optional, see SCE_File_ReadAt() */
+    SCE_FPWriteFunc xpwrite;
+    SCE_FReadVFunc xreadv;      /* optional, see SCE_File_ReadV() */
+    SCE_FWriteVFunc xwritev;
 };
 
 struct sce_sfile {
@@ -81,6 +103,12 @@ int SCE_File_Close (SCE_SFile*);
 size_t SCE_File_Read (void*, size_t, size_t, SCE_SFile*);
 size_t SCE_File_Write (const void*, size_t, size_t, SCE_SFile*);
 
+size_t SCE_File_ReadAt (void*, size_t, size_t, long, SCE_SFile*);
+size_t SCE_File_WriteAt (const void*, size_t, size_t, long, SCE_SFile*);
+
+size_t SCE_File_ReadV (const SCE_SFileIOVec*, size_t, SCE_SFile*);
+size_t SCE_File_WriteV (const SCE_SFileIOVec*, size_t, SCE_SFile*);
+
 int SCE_File_Seek (SCE_SFile*, long, int);
 long SCE_File_Tell (SCE_SFile*);
 void SCE_File_Rewind (SCE_SFile*);
@@ -89,6 +117,9 @@ int SCE_File_Flush (SCE_SFile*);
 int SCE_File_Truncate (SCE_SFile*, size_t);
 size_t SCE_File_Length (const SCE_SFile*);
 
+const void* SCE_File_Map (SCE_SFile*, size_t*);
+void SCE_File_Unmap (SCE_SFile*, const void*, size_t);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,75 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEFILEASYNC_H
+#define SCEFILEASYNC_H
+
+#include <stddef.h>
+#include "SCE/utils/SCEFile.h"
+#include "SCE/utils/SCEThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Number of I/O threads started by the first request */
+#define SCE_FILE_ASYNC_THREADS 2
+
+typedef struct sce_sfilerequest SCE_SFileRequest;
+typedef void (*SCE_FFileRequestCallback)(SCE_SFileRequest*, void*);
+
+/**
+ * \brief An asynchronous read or write, owned by the caller
+ * \sa SCE_File_ReadAsync(), SCE_File_WriteAsync()
+ */
+struct sce_sfilerequest {
+    SCE_SFile *fp;
+    void *data;
+    size_t size;                /* bytes to transfer */
+    long offset;
+    int write;
+    size_t done;                /* bytes transferred */
+    SCE_FFileRequestCallback callback;
+    void *udata;                /* argument of callback */
+    SCE_SThreadTask task;
+    SCE_SThreadGroup group;
+};
+
+int SCE_Init_FileAsync (void);
+void SCE_Quit_FileAsync (void);
+
+void SCE_File_InitRequest (SCE_SFileRequest*);
+void SCE_File_SetRequestCallback (SCE_SFileRequest*, SCE_FFileRequestCallback,
+                                  void*);
+
+int SCE_File_ReadAsync (SCE_SFileRequest*, SCE_SFile*, void*, size_t, long);
+int SCE_File_WriteAsync (SCE_SFileRequest*, SCE_SFile*, const void*, size_t,
+                         long);
+
+int SCE_File_PollRequest (SCE_SFileRequest*);
+size_t SCE_File_WaitRequest (SCE_SFileRequest*);
+size_t SCE_File_GetRequestResult (const SCE_SFileRequest*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 21/09/2007
-   updated: 14/03/2012 */
+   updated: 17/10/2026 */
 
 #ifndef SCELIST_H
 #define SCELIST_H
@@ -57,6 +57,9 @@ struct sce_slist {
     SCE_FListFreeFunc2 f2;    /**< Second free function */
     void *f2arg;              /**< \c f2 first argument */
     int canfree;              /**< Does the list can delete iterators? */
+    unsigned int length;      /**< Number of elements, kept by the list
+                               *   functions, reliable only if \c counted */
+    int counted;              /**< Is \c length trusted? */
 };
 
 /** @} */
@@ -77,6 +80,8 @@ void SCE_List_Delete (SCE_SList*);
 void SCE_List_CanDeleteIterators (SCE_SList*, int);
 void SCE_List_SetFreeFunc (SCE_SList*, SCE_FListFreeFunc);
 void SCE_List_SetFreeFunc2 (SCE_SList*, SCE_FListFreeFunc2, void*);
+void SCE_List_SetCounted (SCE_SList*, int);
+int SCE_List_CheckCounter (const SCE_SList*);
 
 int SCE_List_IsAttached (const SCE_SListIterator*);
 
@@ -86,6 +91,8 @@ void SCE_List_Append (SCE_SListIterator*, SCE_SListIterator*);
 
 void SCE_List_Prependl (SCE_SList*, SCE_SListIterator*);
 void SCE_List_Appendl (SCE_SList*, SCE_SListIterator*);
+void SCE_List_Prependc (SCE_SList*, SCE_SListIterator*, SCE_SListIterator*);
+void SCE_List_Appendc (SCE_SList*, SCE_SListIterator*, SCE_SListIterator*);
 int SCE_List_PrependNew (SCE_SListIterator*, void*);
 int SCE_List_AppendNew (SCE_SListIterator*, void*);
 int SCE_List_PrependNewl (SCE_SList*, void*);
@@ -95,6 +102,7 @@ void SCE_List_AppendAll (SCE_SList*, SCE_SList*);
 
 void SCE_List_Remove (SCE_SListIterator*);
 void SCE_List_Removel (SCE_SListIterator*);
+void SCE_List_Removec (SCE_SList*, SCE_SListIterator*);
 SCE_SListIterator* SCE_List_RemoveFirst (SCE_SList*);
 SCE_SListIterator* SCE_List_RemoveLast (SCE_SList*);
 
@@ -143,6 +151,7 @@ void SCE_List_QuickSortRange (SCE_SList*, unsigned int, unsigned int,
                               SCE_FListCompareData);
 void SCE_List_QuickSort (SCE_SList*, SCE_FListCompareData);
 void SCE_List_GnomeSort (SCE_SList*, SCE_FListCompareData);
+void SCE_List_MergeSort (SCE_SList*, SCE_FListCompareData);
 
 /**
  * \brief Sorts a list
@@ -155,10 +164,11 @@ void SCE_List_GnomeSort (SCE_SList*, SCE_FListCompareData);
  * \warning Do NOT consider this macro expands to what it expands now, it may
  *          change later.
  * 
+ * \see SCE_List_MergeSort()
  * \see SCE_List_QuickSort()
  * \see SCE_List_GnomeSort()
  */
-#define SCE_List_Sort(l, func) (SCE_List_GnomeSort ((l), (func)))
+#define SCE_List_Sort(l, func) (SCE_List_MergeSort ((l), (func)))
 
 /**
  * \brief Gets data of an iterator
@@ -175,6 +185,7 @@ do {\
     ((SCE_SListIterator*)(it))->next = ((SCE_SList*)(l))->first.next;   \
     ((SCE_SList*)(l))->first.next->prev = ((SCE_SListIterator*)(it));   \
     ((SCE_SList*)(l))->first.next = ((SCE_SListIterator*)(it));         \
+    ((SCE_SList*)(l))->length++;                                        \
 } while (0)
 
 #define SCE_List_Appendl(l, it)\
@@ -183,6 +194,7 @@ do {\
     ((SCE_SListIterator*)(it))->prev = ((SCE_SList*)(l))->last.prev;    \
     ((SCE_SList*)(l))->last.prev->next = ((SCE_SListIterator*)(it));    \
     ((SCE_SList*)(l))->last.prev = ((SCE_SListIterator*)(it));          \
+    ((SCE_SList*)(l))->length++;                                        \
 } while (0)
 
 #define SCE_List_Removel(it)\
@@ -17,12 +17,13 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 26/01/2009
-   updated: 27/01/2009 */
+   updated: 17/10/2026 */
 
 #ifndef SCELISTFASTFOREACH_H
 #define SCELISTFASTFOREACH_H
 
 #include <SCE/utils/SCEList.h>
+#include <SCE/utils/SCEThreadPool.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -33,6 +34,14 @@ typedef void (*SCE_FListFastForeach)(SCE_SListIterator*, void*);
 typedef void (*SCE_FListFastForeach2)(void*, void*);
 typedef void (*SCE_FListFastForeach3)(SCE_SListIterator*);
 typedef void (*SCE_FListFastForeach4)(void*);
+typedef void (*SCE_FListBatchForeach)(void**, unsigned int, void*);
+
+/** \brief Default number of elements given at once by
+ * SCE_List_BatchForEach() */
+#define SCE_LIST_BATCH_SIZE 16
+/** \brief Maximum number of elements given at once by
+ * SCE_List_BatchForEach() */
+#define SCE_LIST_MAX_BATCH_SIZE 64
 
 int SCE_Init_FastList (void);
 void SCE_Quit_FastList (void);
@@ -45,6 +54,11 @@ void SCE_List_FastForEach3 (SCE_SList*, unsigned int,
                            SCE_FListFastForeach3);
 void SCE_List_FastForEach4 (SCE_SList*, unsigned int,
                            SCE_FListFastForeach4);
+void SCE_List_BatchForEach (SCE_SList*, unsigned int, SCE_FListBatchForeach,
+                            void*);
+
+int SCE_List_ParallelForEach (SCE_SThreadPool*, SCE_SList*, unsigned int,
+                              SCE_FListFastForeach2, void**);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 13/02/2009
-   updated: 10/04/2010 */
+   updated: 17/10/2026 */
 
 #ifndef SCEMACROS_H
 #define SCEMACROS_H
@@ -105,6 +105,13 @@ extern "C" {
 #define SCE_GNUC_ALLOC_SIZE2(x,y)
 #endif
 
+/* asks the CPU to bring the memory at p into the cache */
+#if     __GNUC__ > 3 || (__GNUC__ == 3 && __GNUC_MINOR__ >= 1)
+#define SCE_GNUC_PREFETCH(p) __builtin_prefetch (p)
+#else
+#define SCE_GNUC_PREFETCH(p)
+#endif
+
 #if     __GNUC__ > 2 || (__GNUC__ == 2 && __GNUC_MINOR__ > 4)
 #define SCE_GNUC_PRINTF( format_idx, arg_idx )    \
   __attribute__((__format__ (__printf__, format_idx, arg_idx)))
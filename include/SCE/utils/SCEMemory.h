@@ -17,12 +17,13 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 22/12/2006
-   updated: 23/10/2008 */
+   updated: 17/10/2026 */
 
 #ifndef SCEMEMORY_H
 #define SCEMEMORY_H
 
 #include <stdlib.h>
+#include <stdio.h>
 #include "SCE/utils/SCEMacros.h"
 
 #ifdef __cplusplus
@@ -34,14 +35,22 @@ extern "C" {
  * @{
  */
 
+/**
+ * \brief Biggest size of the blocks served by the small objects allocator
+ * \see SCE_Mem_RawAlloc()
+ */
+#define SCE_MEM_SMALL_SIZE 128
+
 /**
  * \brief Main malloc wrapper
  * \see SCE_Mem_Alloc()
  */
 #ifdef SCE_DEBUG
 #define SCE_malloc(size) SCE_Mem_Alloc(__FILE__, __LINE__, size)
+#elif defined(SCE_MEM_STATS)
+#define SCE_malloc(size) SCE_Mem_StatAlloc(__FILE__, __LINE__, size)
 #else
-#define SCE_malloc(size) malloc(size)
+#define SCE_malloc(size) SCE_Mem_RawAlloc(size)
 #endif
 /**
  * \brief Main calloc wrapper
@@ -49,8 +58,10 @@ extern "C" {
  */
 #ifdef SCE_DEBUG
 #define SCE_calloc(size, nb) SCE_Mem_Calloc(__FILE__, __LINE__, size, nb)
+#elif defined(SCE_MEM_STATS)
+#define SCE_calloc(size, nb) SCE_Mem_StatCalloc(__FILE__, __LINE__, size, nb)
 #else
-#define SCE_calloc(size, nb) calloc(size, nb)
+#define SCE_calloc(size, nb) SCE_Mem_RawCalloc(size, nb)
 #endif
 /**
  * \brief Main realloc wrapper
@@ -58,8 +69,10 @@ extern "C" {
  */
 #ifdef SCE_DEBUG
 #define SCE_realloc(ptr, size) SCE_Mem_Realloc(__FILE__, __LINE__, ptr, size)
+#elif defined(SCE_MEM_STATS)
+#define SCE_realloc(ptr, size) SCE_Mem_StatRealloc(__FILE__, __LINE__, ptr, size)
 #else
-#define SCE_realloc(ptr, size) realloc(ptr, size)
+#define SCE_realloc(ptr, size) SCE_Mem_RawRealloc(ptr, size)
 #endif
 /**
  * \brief Main free wrapper
@@ -70,10 +83,83 @@ extern "C" {
  */
 #ifdef SCE_DEBUG
 #define SCE_free(p) SCE_Mem_Free (__FILE__, __LINE__, p)
+#elif defined(SCE_MEM_STATS)
+#define SCE_free SCE_Mem_StatFree
+#else
+#define SCE_free SCE_Mem_RawFree
+#endif
+/**
+ * \brief Allocates a block aligned on \p align bytes
+ * \see SCE_Mem_AllocAligned(), SCE_free_aligned()
+ */
+#ifdef SCE_DEBUG
+#define SCE_malloc_aligned(align, size)\
+    SCE_Mem_DebugAllocAligned(__FILE__, __LINE__, align, size)
+#else
+#define SCE_malloc_aligned(align, size) SCE_Mem_AllocAligned(align, size)
+#endif
+/**
+ * \brief Frees a block allocated by SCE_malloc_aligned()
+ * \see SCE_Mem_FreeAligned()
+ */
+#ifdef SCE_DEBUG
+#define SCE_free_aligned(p) SCE_Mem_Free (__FILE__, __LINE__, p)
 #else
-#define SCE_free free
+#define SCE_free_aligned SCE_Mem_FreeAligned
 #endif
 
+/**
+ * \brief Number of buckets of the size histogram, bucket \c i counts the
+ * allocations of [2^(i-1), 2^i) bytes, the last one counts everything bigger
+ * \see SCE_SMemStats
+ */
+#define SCE_MEM_HISTOGRAM_SIZE 32
+
+/**
+ * \brief Allocation counters
+ */
+typedef struct sce_smemcounters SCE_SMemCounters;
+struct sce_smemcounters {
+    size_t live_bytes;          /**< Bytes currently allocated */
+    size_t peak_bytes;          /**< Highest value reached by \c live_bytes */
+    size_t total_bytes;         /**< Bytes allocated since the beginning */
+    size_t n_allocs;            /**< Number of allocations */
+    size_t n_frees;             /**< Number of frees */
+};
+
+/**
+ * \brief Global allocation statistics
+ * \see SCE_Mem_GetStats()
+ */
+typedef struct sce_smemstats SCE_SMemStats;
+struct sce_smemstats {
+    SCE_SMemCounters counters;
+    size_t histogram[SCE_MEM_HISTOGRAM_SIZE]; /**< Allocations by size */
+};
+
+/**
+ * \brief Allocation statistics of a call site
+ * \see SCE_Mem_GetSiteStats()
+ */
+typedef struct sce_smemsitestats SCE_SMemSiteStats;
+struct sce_smemsitestats {
+    const char *file;
+    unsigned int line;
+    SCE_SMemCounters counters;
+};
+
+/**
+ * \brief Allocation statistics of a thread
+ * \see SCE_Mem_GetThreadStats()
+ */
+typedef struct sce_smemthreadstats SCE_SMemThreadStats;
+struct sce_smemthreadstats {
+    unsigned long id;           /**< Number of the thread, in order of
+                                   first allocation */
+    int alive;                  /**< Is the thread still running */
+    SCE_SMemCounters counters;
+};
+
 /** @} */
 
 int SCE_Init_Mem (void);
@@ -89,6 +175,40 @@ void* SCE_Mem_Realloc (const char*, unsigned int, void*, size_t)
     SCE_GNUC_ALLOC_SIZE (4);
 void SCE_Mem_Free (const char*, int, void*);
 
+void* SCE_Mem_RawAlloc (size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (1);
+void* SCE_Mem_RawCalloc (size_t, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE2 (1, 2);
+void* SCE_Mem_RawRealloc (void*, size_t)
+    SCE_GNUC_ALLOC_SIZE (2);
+void SCE_Mem_RawFree (void*);
+void SCE_Mem_FlushCache (void);
+
+void* SCE_Mem_AllocAligned (size_t, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (2);
+void SCE_Mem_FreeAligned (void*);
+void* SCE_Mem_DebugAllocAligned (const char*, unsigned int, size_t, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (4);
+
+void* SCE_Mem_StatAlloc (const char*, unsigned int, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE (3);
+void* SCE_Mem_StatCalloc (const char*, unsigned int, size_t, size_t)
+    SCE_GNUC_MALLOC
+    SCE_GNUC_ALLOC_SIZE2 (3, 4);
+void* SCE_Mem_StatRealloc (const char*, unsigned int, void*, size_t)
+    SCE_GNUC_ALLOC_SIZE (4);
+void SCE_Mem_StatFree (void*);
+
+void SCE_Mem_GetStats (SCE_SMemStats*);
+size_t SCE_Mem_GetSiteStats (SCE_SMemSiteStats*, size_t);
+size_t SCE_Mem_GetThreadStats (SCE_SMemThreadStats*, size_t);
+int SCE_Mem_DumpStats (FILE*);
+
 void* SCE_Mem_Dup (const void*, size_t)
     SCE_GNUC_MALLOC
     SCE_GNUC_ALLOC_SIZE (2);
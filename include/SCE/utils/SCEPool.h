@@ -0,0 +1,72 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCEPOOL_H
+#define SCEPOOL_H
+
+#include <stddef.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Default number of elements of a chunk of a pool */
+#define SCE_POOL_DEFAULT_CHUNK_SIZE 64
+
+typedef struct sce_spool SCE_SPool;
+struct sce_spool {
+    size_t elt_size;            /* size of one element, padding included */
+    size_t chunk_size;          /* number of elements per chunk */
+    void *chunks;               /* list of the allocated chunks */
+    void *freeelts;             /* list of the free elements */
+    size_t n_used;              /* number of elements given out */
+    int threadsafe;
+    pthread_mutex_t mutex;
+};
+
+/**
+ * \brief Initializes a pool of elements of the given type
+ * \see SCE_Pool_Init()
+ */
+#define SCE_Pool_InitTyped(pool, type) SCE_Pool_Init (pool, sizeof (type))
+/**
+ * \brief Takes an element of the given type from a pool
+ * \see SCE_Pool_Alloc()
+ */
+#define SCE_Pool_New(pool, type) ((type*)SCE_Pool_Alloc (pool))
+
+void SCE_Pool_Init (SCE_SPool*, size_t);
+void SCE_Pool_Clear (SCE_SPool*);
+
+void SCE_Pool_SetChunkSize (SCE_SPool*, size_t);
+int SCE_Pool_SetThreadSafe (SCE_SPool*, int);
+
+void* SCE_Pool_Alloc (SCE_SPool*);
+void SCE_Pool_Free (SCE_SPool*, void*);
+
+size_t SCE_Pool_GetNumUsed (const SCE_SPool*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -0,0 +1,61 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCERINGARRAY_H
+#define SCERINGARRAY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sce_sringarray SCE_SRingArray;
+struct sce_sringarray {
+    unsigned char *ptr;
+    size_t head;                /* offset of the first byte */
+    size_t size;                /* number of bytes stored */
+    size_t capacity;            /* allocated size, a power of two */
+};
+
+void SCE_RingArray_Init (SCE_SRingArray*);
+void SCE_RingArray_Clear (SCE_SRingArray*);
+
+int SCE_RingArray_Reserve (SCE_SRingArray*, size_t);
+
+int SCE_RingArray_PushBack (SCE_SRingArray*, const void*, size_t);
+int SCE_RingArray_PushFront (SCE_SRingArray*, const void*, size_t);
+size_t SCE_RingArray_PopFront (SCE_SRingArray*, void*, size_t);
+size_t SCE_RingArray_PopBack (SCE_SRingArray*, void*, size_t);
+size_t SCE_RingArray_Read (const SCE_SRingArray*, size_t, void*, size_t);
+
+unsigned int SCE_RingArray_GetSpans (const SCE_SRingArray*, void**, size_t*,
+                                     void**, size_t*);
+void* SCE_RingArray_Linearize (SCE_SRingArray*);
+
+size_t SCE_RingArray_GetSize (const SCE_SRingArray*);
+size_t SCE_RingArray_GetCapacity (const SCE_SRingArray*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
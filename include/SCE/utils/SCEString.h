@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 28/02/2007
-   updated: 20/08/2010 */
+   updated: 17/10/2026 */
 
 #ifndef SCESTRING_H
 #define SCESTRING_H
@@ -25,6 +25,7 @@
 #include <string.h>
 #include <stdarg.h>
 #include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEArena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,6 +54,11 @@ char* SCE_String_NDup (const char*, size_t);
 char* SCE_String_CatDup (const char*, const char*);
 char* SCE_String_CatDupMulti (const char* str, ...) SCE_GNUC_NULL_TERMINATED;
 
+char* SCE_String_DupArena (SCE_SArena*, const char*);
+char* SCE_String_CatDupArena (SCE_SArena*, const char*, const char*);
+char* SCE_String_CatDupMultiArena (SCE_SArena*, const char*, ...)
+    SCE_GNUC_NULL_TERMINATED;
+
 int SCE_String_ReplaceChar (char*, char, char);
 
 void SCE_String_MergePaths (char*, const char*, const char*);
@@ -0,0 +1,84 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#ifndef SCETHREADPOOL_H
+#define SCETHREADPOOL_H
+
+#include <pthread.h>
+#include "SCE/utils/SCEList.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*SCE_FThreadTaskFunc)(void*);
+
+/**
+ * \brief Set of tasks that can be waited for together
+ * \sa SCE_ThreadPool_Wait()
+ */
+typedef struct sce_sthreadgroup SCE_SThreadGroup;
+struct sce_sthreadgroup {
+    unsigned int pending;       /* number of tasks not done yet */
+};
+
+/**
+ * \brief A task to run on a thread pool, owned by the caller
+ */
+typedef struct sce_sthreadtask SCE_SThreadTask;
+struct sce_sthreadtask {
+    SCE_FThreadTaskFunc f;
+    void *arg;                  /* argument of f */
+    SCE_SThreadGroup *group;
+    SCE_SListIterator it;
+};
+
+typedef struct sce_sthreadpool SCE_SThreadPool;
+struct sce_sthreadpool {
+    pthread_t *threads;
+    unsigned int n_threads;
+    SCE_SList tasks;            /* queued tasks */
+    pthread_mutex_t mutex;
+    pthread_cond_t work;        /* signaled when a task is queued */
+    pthread_cond_t done;        /* signaled when a group is done */
+    int quit;
+};
+
+int SCE_Init_ThreadPool (void);
+void SCE_Quit_ThreadPool (void);
+
+void SCE_ThreadPool_Init (SCE_SThreadPool*);
+void SCE_ThreadPool_Clear (SCE_SThreadPool*);
+int SCE_ThreadPool_Start (SCE_SThreadPool*, unsigned int);
+unsigned int SCE_ThreadPool_GetNumThreads (const SCE_SThreadPool*);
+SCE_SThreadPool* SCE_ThreadPool_GetDefault (void);
+
+void SCE_ThreadPool_InitGroup (SCE_SThreadGroup*);
+void SCE_ThreadPool_InitTask (SCE_SThreadTask*, SCE_FThreadTaskFunc, void*);
+void SCE_ThreadPool_Push (SCE_SThreadPool*, SCE_SThreadGroup*,
+                          SCE_SThreadTask*);
+void SCE_ThreadPool_Wait (SCE_SThreadPool*, SCE_SThreadGroup*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* guard */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 17/04/2010
-   updated: 08/04/2012 */
+   updated: 17/10/2026 */
 
 #ifndef SCETYPE_H
 #define SCETYPE_H
@@ -25,6 +25,9 @@
 /* external dependencies */
 #include <stdlib.h>
 
+/* internal dependencies */
+#include "SCE/utils/SCEArena.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -82,6 +85,7 @@ size_t SCE_Type_Sizeof (SCE_EType);
 
 void SCE_Type_Convert (int, void*, int, const void*, size_t);
 void* SCE_Type_ConvertDup (int, int, const void*, size_t);
+void* SCE_Type_ConvertDupArena (SCE_SArena*, int, int, const void*, size_t);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -29,13 +29,23 @@
 #include "SCE/utils/SCEMacros.h"
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEArena.h"
+#include "SCE/utils/SCEPool.h"
 #include "SCE/utils/SCEArray.h"
+#include "SCE/utils/SCERingArray.h"
 #include "SCE/utils/SCEArray2D.h"
+#include "SCE/utils/SCEArray3D.h"
+#include "SCE/utils/SCEThreadPool.h"
+#include "SCE/utils/SCEAtomicList.h"
+#include "SCE/utils/SCEDynVector.h"
 #include "SCE/utils/SCETime.h"
 #include "SCE/utils/SCEType.h"
 #include "SCE/utils/SCEEncode.h"
 #include "SCE/utils/SCEFile.h"
 #include "SCE/utils/SCENullFileSystem.h"
+#include "SCE/utils/SCEMmapFileSystem.h"
+#include "SCE/utils/SCEBufferedFileSystem.h"
+#include "SCE/utils/SCEFileAsync.h"
 
 #include "SCE/utils/SCEMath.h"
 #include "SCE/utils/SCEVector.h"
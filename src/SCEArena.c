@@ -0,0 +1,294 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <string.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEArena.h"
+
+/**
+ * \file SCEArena.c
+ * \copydoc arena
+ * \brief Linear allocator
+ *
+ * \file SCEArena.h
+ * \copydoc arena
+ * \brief Linear allocator
+ */
+
+/**
+ * \defgroup arena Linear allocator
+ * \ingroup utils
+ *
+ * An arena hands out memory by bumping a pointer into big chunks; the
+ * allocations are never freed individually, instead the whole arena is reset
+ * or rewound to a previously taken mark. Useful for scratch memory that only
+ * lives for a frame or while loading a file.
+ */
+
+/** @{ */
+
+struct sce_sarenachunk {
+    SCE_SArenaChunk *next;
+    size_t size;                /* usable size */
+    size_t used;                /* offset of the first free byte */
+};
+
+#define SCE_ARENA_ALIGN(x)\
+    (((x) + SCE_ARENA_ALIGNMENT - 1) & ~(size_t)(SCE_ARENA_ALIGNMENT - 1))
+
+#define SCE_ARENA_CHUNK_HEADER_SIZE SCE_ARENA_ALIGN (sizeof (SCE_SArenaChunk))
+
+#define SCE_Arena_GetChunkData(c)\
+    ((unsigned char*)(c) + SCE_ARENA_CHUNK_HEADER_SIZE)
+
+
+static SCE_SArenaChunk* SCE_Arena_CreateChunk (size_t size)
+{
+    SCE_SArenaChunk *c = NULL;
+    if (size > (size_t)-1 - SCE_ARENA_CHUNK_HEADER_SIZE) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    if (!(c = SCE_malloc (SCE_ARENA_CHUNK_HEADER_SIZE + size)))
+        SCEE_LogSrc ();
+    else {
+        c->next = NULL;
+        c->size = size;
+        c->used = 0;
+    }
+    return c;
+}
+
+
+/**
+ * \brief Initializes an arena
+ *
+ * No memory is allocated until the first call to SCE_Arena_Alloc() or
+ * SCE_Arena_Reserve(). The arena is growable by default.
+ */
+void SCE_Arena_Init (SCE_SArena *a)
+{
+    a->first = a->current = NULL;
+    a->chunk_size = SCE_ARENA_DEFAULT_CHUNK_SIZE;
+    a->growable = SCE_TRUE;
+}
+/**
+ * \brief Frees all the memory of an arena
+ *
+ * Every pointer given by the arena becomes invalid.
+ */
+void SCE_Arena_Clear (SCE_SArena *a)
+{
+    SCE_SArenaChunk *c = a->first, *next = NULL;
+    while (c) {
+        next = c->next;
+        SCE_free (c);
+        c = next;
+    }
+    a->first = a->current = NULL;
+}
+
+/**
+ * \brief Sets the size of the chunks allocated by an arena
+ * \param size minimum size of a chunk, in bytes
+ *
+ * Bigger requests get a chunk of their own size.
+ */
+void SCE_Arena_SetChunkSize (SCE_SArena *a, size_t size)
+{
+    a->chunk_size = size;
+}
+/**
+ * \brief Defines whether an arena can allocate more than one chunk
+ *
+ * A non growable arena fails to allocate once its first chunk is full, use
+ * SCE_Arena_Reserve() to give it the wanted capacity.
+ */
+void SCE_Arena_SetGrowable (SCE_SArena *a, int growable)
+{
+    a->growable = growable;
+}
+
+/**
+ * \brief Makes sure \p size bytes can be allocated from an arena without
+ * allocating any memory
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_Arena_Reserve (SCE_SArena *a, size_t size)
+{
+    SCE_SArenaMark mark;
+    SCE_Arena_Mark (a, &mark);
+    if (!SCE_Arena_Alloc (a, size)) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    SCE_Arena_Rewind (a, &mark);
+    return SCE_OK;
+}
+
+
+/**
+ * \brief Allocates memory from an arena
+ * \param size number of bytes wanted
+ * \returns a pointer aligned on SCE_ARENA_ALIGNMENT bytes or NULL on error
+ *
+ * The memory is given back by SCE_Arena_Rewind(), SCE_Arena_Reset() and
+ * SCE_Arena_Clear(), it must not be freed with SCE_free().
+ */
+void* SCE_Arena_Alloc (SCE_SArena *a, size_t size)
+{
+    SCE_SArenaChunk *c = a->current;
+    size_t offset;
+
+    if (c) {
+        offset = SCE_ARENA_ALIGN (c->used);
+        if (offset <= c->size && size <= c->size - offset) {
+            c->used = offset + size;
+            return SCE_Arena_GetChunkData (c) + offset;
+        }
+        /* reuse the chunks left by a previous rewind */
+        while (c->next) {
+            c = c->next;
+            c->used = 0;
+            if (size <= c->size) {
+                a->current = c;
+                c->used = size;
+                return SCE_Arena_GetChunkData (c);
+            }
+        }
+    }
+
+    if (a->first && !a->growable) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("arena is full, can't allocate %lu bytes",
+                     (unsigned long)size);
+        return NULL;
+    }
+    if (!(c = SCE_Arena_CreateChunk (size > a->chunk_size ?
+                                     size : a->chunk_size))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    if (a->current) {
+        c->next = a->current->next;
+        a->current->next = c;
+    } else {
+        c->next = a->first;
+        a->first = c;
+    }
+    a->current = c;
+    c->used = size;
+    return SCE_Arena_GetChunkData (c);
+}
+
+/**
+ * \brief Allocates zeroed memory from an arena
+ * \param size size of one element
+ * \param n number of elements
+ * \sa SCE_Arena_Alloc()
+ */
+void* SCE_Arena_Calloc (SCE_SArena *a, size_t size, size_t n)
+{
+    void *p = NULL;
+    if (n && size > (size_t)-1 / n) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    if (!(p = SCE_Arena_Alloc (a, size * n)))
+        SCEE_LogSrc ();
+    else
+        memset (p, 0, size * n);
+    return p;
+}
+
+/**
+ * \brief Copies memory into an arena
+ * \param p the memory to duplicate
+ * \param size size of \p p, in bytes
+ * \sa SCE_Mem_Dup()
+ */
+void* SCE_Arena_Dup (SCE_SArena *a, const void *p, size_t size)
+{
+    void *new = NULL;
+    if (!(new = SCE_Arena_Alloc (a, size)))
+        SCEE_LogSrc ();
+    else
+        memcpy (new, p, size);
+    return new;
+}
+
+
+/**
+ * \brief Gets the current position of an arena
+ * \param mark where to store the position
+ * \sa SCE_Arena_Rewind()
+ */
+void SCE_Arena_Mark (const SCE_SArena *a, SCE_SArenaMark *mark)
+{
+    mark->chunk = a->current;
+    mark->offset = a->current ? a->current->used : 0;
+}
+/**
+ * \brief Frees everything allocated from an arena since a mark was taken
+ * \param mark a mark given by SCE_Arena_Mark()
+ *
+ * The chunks are kept for further allocations. Marks taken after \p mark
+ * become invalid.
+ */
+void SCE_Arena_Rewind (SCE_SArena *a, const SCE_SArenaMark *mark)
+{
+    if (!mark->chunk)
+        SCE_Arena_Reset (a);
+    else {
+        a->current = mark->chunk;
+        a->current->used = mark->offset;
+    }
+}
+/**
+ * \brief Frees everything allocated from an arena, but keeps its chunks
+ * \sa SCE_Arena_Clear()
+ */
+void SCE_Arena_Reset (SCE_SArena *a)
+{
+    a->current = a->first;
+    if (a->current)
+        a->current->used = 0;
+}
+
+/**
+ * \brief Gets the number of bytes currently allocated from an arena,
+ * alignment padding included
+ */
+size_t SCE_Arena_GetUsedSize (const SCE_SArena *a)
+{
+    SCE_SArenaChunk *c = NULL;
+    size_t size = 0;
+    if (a->current) {
+        for (c = a->first; c != a->current; c = c->next)
+            size += c->used;
+        size += c->used;
+    }
+    return size;
+}
+
+/** @} */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 17/05/2012
-   updated: 18/05/2012 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 #include <string.h>
@@ -30,97 +30,333 @@ void SCE_Array_Init (SCE_SArray *a)
 {
     a->ptr = NULL;
     a->removed_front = 0;
-    a->removed_back = 0;
     a->size = 0;
     a->allocated = 0;
+    a->reserved = 0;
+    a->growth = SCE_ARRAY_DEFAULT_GROWTH;
+    a->alignment = 0;
+}
+static void SCE_Array_Free (SCE_SArray *a)
+{
+    if (a->alignment)
+        SCE_free_aligned (a->ptr);
+    else
+        SCE_free (a->ptr);
 }
 void SCE_Array_Clear (SCE_SArray *a)
 {
-    SCE_free (a->ptr);
+    SCE_Array_Free (a);
+    a->reserved = 0;
+}
+
+/**
+ * \brief Sets the alignment of the storage of an array
+ * \param align alignment in bytes, must be a power of two, 0 means the one
+ * of SCE_malloc()
+ *
+ * Must be called before anything is added to the array. The pointer returned
+ * by SCE_Array_Get() keeps this alignment as long as the bytes removed with
+ * SCE_Array_PopFront() are a multiple of it.
+ */
+void SCE_Array_SetAlignment (SCE_SArray *a, size_t align)
+{
+    a->alignment = align;
 }
 
-static int SCE_Array_Realloc (SCE_SArray *a, size_t size)
+/* moves the content of the array into a buffer of \p capacity bytes, the
+   bytes removed from the front are dropped */
+static int SCE_Array_Realloc (SCE_SArray *a, size_t capacity)
 {
     unsigned char *ptr = NULL;
-    size_t pot = SCE_Math_NextPowerOfTwo (SCE_Array_GetSize (a));
+    size_t size = SCE_Array_GetSize (a);
 
-    if (a->allocated >= pot && a->allocated < 2 * pot) {
-        memmove (a->ptr, SCE_Array_Get (a), size);
+    if (!capacity) {
+        SCE_Array_Free (a);
+        a->ptr = NULL;
+    } else if (!a->alignment && !a->removed_front) {
+        /* may grow in place */
+        if (!(ptr = SCE_realloc (a->ptr, capacity))) {
+            SCEE_LogSrc ();
+            return SCE_ERROR;
+        }
+        a->ptr = ptr;
     } else {
-        a->allocated = pot;
-        if (!(ptr = SCE_malloc (a->allocated))) {
+        if (a->alignment)
+            ptr = SCE_malloc_aligned (a->alignment, capacity);
+        else
+            ptr = SCE_malloc (capacity);
+        if (!ptr) {
             SCEE_LogSrc ();
             return SCE_ERROR;
         }
-        if (a->ptr) {
+        if (a->ptr)
             memcpy (ptr, SCE_Array_Get (a), size);
-            SCE_free (a->ptr);
-        }
+        SCE_Array_Free (a);
         a->ptr = ptr;
     }
 
-    a->size -= a->removed_front + a->removed_back;
-    a->removed_front = a->removed_back = 0;
+    a->allocated = capacity;
+    a->size = size;
+    a->removed_front = 0;
     return SCE_OK;
 }
 
-int SCE_Array_Append (SCE_SArray *a, void *data, size_t size)
+/* gives \p n times the growth factor, computed on integers: a float product
+   loses precision on big arrays and truncates small ones to an exact fit.
+   The factor is rounded to 1/256, the step is SCE_ARRAY_MIN_CAPACITY at
+   least and 0 is returned on overflow */
+static size_t SCE_Array_Scale (const SCE_SArray *a, size_t n)
 {
-    size_t offset;
-    size_t old_size;
+    size_t k, step;
 
-    old_size = SCE_Array_GetSize (a);
-    offset = a->size - a->removed_back;
-    a->size += size;
-    if (a->size > a->allocated) {
-        offset -= a->removed_front;
-        if (SCE_Array_Realloc (a, old_size) < 0) {
-            SCEE_LogSrc ();
-            return SCE_ERROR;
-        }
+    k = (size_t)((a->growth - 1.0f) * 256.0f + 0.5f);
+    step = (n / 256) * k;
+    if (k && step / k != n / 256)
+        return 0;
+    step += (n % 256) * k / 256;
+    step = MAX (step, SCE_ARRAY_MIN_CAPACITY);
+    if (n > (size_t)-1 - step)
+        return 0;
+    return n + step;
+}
+
+/* makes room for \p size more bytes at the end of the array */
+static int SCE_Array_Grow (SCE_SArray *a, size_t size)
+{
+    size_t needed, capacity;
+
+    needed = SCE_Array_GetSize (a) + size;
+    if (needed < size) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return SCE_ERROR;
+    }
+    if (a->size + size <= a->allocated)
+        return SCE_OK;
+
+    /* moving the data back to the front is cheaper than growing, and
+       amortized by the bytes that were removed */
+    if (needed <= a->allocated && a->removed_front >= SCE_Array_GetSize (a)) {
+        memmove (a->ptr, SCE_Array_Get (a), SCE_Array_GetSize (a));
+        a->size -= a->removed_front;
+        a->removed_front = 0;
+        return SCE_OK;
+    }
+
+    /* on overflow, only the needed size is tried */
+    capacity = SCE_Array_Scale (a, a->allocated);
+    if (capacity < needed)
+        capacity = needed;
+    if (SCE_Array_Realloc (a, capacity) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/* gives memory back once the array is much smaller than its storage, using
+   the square of the growth factor so that appending and removing around a
+   threshold doesn't reallocate each time. The storage never goes below what
+   was reserved */
+static int SCE_Array_Shrink (SCE_SArray *a)
+{
+    size_t size = SCE_Array_GetSize (a);
+    size_t capacity;
+
+    if (!size) {
+        /* nothing to keep, only reset the offsets */
+        a->size = a->removed_front = 0;
+        return SCE_OK;
+    }
+    if (a->allocated <= MAX (a->reserved, SCE_ARRAY_MIN_CAPACITY) ||
+        size * a->growth * a->growth >= a->allocated)
+        return SCE_OK;
+    capacity = MAX (SCE_Array_Scale (a, size), size);
+    capacity = MAX (capacity, a->reserved);
+    if (SCE_Array_Realloc (a, capacity) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Sets the factor by which the storage of an array grows
+ * \param growth growth factor, must be greater than 1
+ *
+ * The default is SCE_ARRAY_DEFAULT_GROWTH. Appending \c n bytes to an array
+ * costs O(\c n) whatever the size of each append.
+ */
+void SCE_Array_SetGrowthFactor (SCE_SArray *a, float growth)
+{
+    if (growth > 1.0f)
+        a->growth = growth;
+}
+
+/**
+ * \brief Makes sure an array can hold \p size bytes without reallocating
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * Removing bytes from the array doesn't give this storage back, until
+ * SCE_Array_ShrinkToFit() or SCE_Array_Clear() is called.
+ * \sa SCE_Array_ShrinkToFit()
+ */
+int SCE_Array_Reserve (SCE_SArray *a, size_t size)
+{
+    if (size > a->allocated - a->removed_front &&
+        SCE_Array_Realloc (a, MAX (size, SCE_Array_GetSize (a))) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    a->reserved = MAX (a->reserved, size);
+    return SCE_OK;
+}
+
+/**
+ * \brief Reduces the storage of an array to its content
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * Also drops the storage reserved by SCE_Array_Reserve().
+ * \sa SCE_Array_Reserve()
+ */
+int SCE_Array_ShrinkToFit (SCE_SArray *a)
+{
+    a->reserved = 0;
+    if (a->allocated == SCE_Array_GetSize (a))
+        return SCE_OK;
+    if (SCE_Array_Realloc (a, SCE_Array_GetSize (a)) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Gets the number of bytes an array can hold without reallocating
+ */
+size_t SCE_Array_GetCapacity (const SCE_SArray *a)
+{
+    return a->allocated - a->removed_front;
+}
+
+
+int SCE_Array_Append (SCE_SArray *a, void *data, size_t size)
+{
+    if (SCE_Array_Grow (a, size) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
     }
     if (data)
-        memcpy (&a->ptr[offset], data, size);
-    else
-        memset (&a->ptr[offset], 0, size);
+        memcpy (&a->ptr[a->size], data, size);
+    else if (size)
+        memset (&a->ptr[a->size], 0, size);
+    a->size += size;
     return SCE_OK;
 }
 
 int SCE_Array_PopFront (SCE_SArray *a, size_t size)
 {
-    size_t old_size;
-
-    a->removed_front += size;
-    old_size = SCE_Array_GetSize (a);
-    if (old_size * 2 < a->allocated) {
-        if (SCE_Array_Realloc (a, old_size) < 0) {
-            SCEE_LogSrc ();
-            return SCE_ERROR;
-        }
+    a->removed_front += MIN (size, SCE_Array_GetSize (a));
+    if (SCE_Array_Shrink (a) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
     }
     return SCE_OK;
 }
 int SCE_Array_PopBack (SCE_SArray *a, size_t size)
 {
-    size_t old_size;
-
-    a->removed_back += size;
-    old_size = SCE_Array_GetSize (a);
-    if (old_size * 2 < a->allocated) {
-        if (SCE_Array_Realloc (a, old_size) < 0) {
-            SCEE_LogSrc ();
-            return SCE_ERROR;
-        }
+    a->size -= MIN (size, SCE_Array_GetSize (a));
+    if (SCE_Array_Shrink (a) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
     }
     return SCE_OK;
 }
 
+/**
+ * \brief Adds uninitialized bytes at the end of an array
+ * \param size number of bytes to add
+ * \returns a pointer to the new bytes, to be filled by the caller, or NULL
+ * on error
+ *
+ * The pointer is valid until the next call modifying the array, even when
+ * \p size is 0.
+ * \sa SCE_Array_Append()
+ */
+void* SCE_Array_AppendUninit (SCE_SArray *a, size_t size)
+{
+    void *p = NULL;
+    /* an array without storage has no address to give */
+    if (!a->ptr && !size &&
+        SCE_Array_Realloc (a, SCE_ARRAY_MIN_CAPACITY) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    if (SCE_Array_Grow (a, size) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    p = &a->ptr[a->size];
+    a->size += size;
+    return p;
+}
+
+/**
+ * \brief Gives a buffer to an array, without copying it
+ * \param ptr buffer allocated by SCE_malloc(), or SCE_malloc_aligned() with
+ * the alignment of the array if one was set
+ * \param size number of bytes of \p ptr holding data
+ * \param capacity allocated size of \p ptr, or 0 if it is \p size
+ *
+ * The previous content of the array is freed, \p ptr now belongs to the
+ * array and must not be freed by the caller.
+ * \sa SCE_Array_Detach()
+ */
+void SCE_Array_Adopt (SCE_SArray *a, void *ptr, size_t size, size_t capacity)
+{
+    SCE_Array_Clear (a);
+    a->ptr = ptr;
+    a->removed_front = 0;
+    a->size = size;
+    a->allocated = MAX (size, capacity);
+}
+
+/**
+ * \brief Takes the storage of an array, without copying it
+ * \param size if not NULL, receives the number of bytes of the buffer
+ * \returns the content of the array or NULL if it is empty
+ *
+ * The buffer must be freed with SCE_free(), or SCE_free_aligned() if an
+ * alignment was set on the array. The array is left empty.
+ * \sa SCE_Array_Adopt()
+ */
+void* SCE_Array_Detach (SCE_SArray *a, size_t *size)
+{
+    void *ptr = a->ptr;
+    size_t s = SCE_Array_GetSize (a);
+
+    if (!s) {
+        SCE_Array_Free (a);
+        ptr = NULL;
+    } else if (a->removed_front) {
+        /* the buffer must start at the data to be freeable */
+        memmove (a->ptr, SCE_Array_Get (a), s);
+    }
+    if (size)
+        *size = s;
+    a->ptr = NULL;
+    a->removed_front = 0;
+    a->size = 0;
+    a->allocated = 0;
+    a->reserved = 0;
+    return ptr;
+}
+
 void* SCE_Array_Get (const SCE_SArray *a)
 {
-    return &a->ptr[a->removed_front];
+    return a->ptr ? &a->ptr[a->removed_front] : NULL;
 }
 
 size_t SCE_Array_GetSize (const SCE_SArray *a)
 {
-    return a->size - a->removed_front - a->removed_back;
+    return a->size - a->removed_front;
 }
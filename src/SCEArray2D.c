@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 14/06/2013
-   updated: 14/06/2013 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 #include <string.h>
@@ -25,6 +25,7 @@
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEMemory.h"
 #include "SCE/utils/SCEArray2D.h"
+#include "SCEArrayBlock.h"
 
 void SCE_Array2D_Init (SCE_SArray2D *a)
 {
@@ -33,10 +34,21 @@ void SCE_Array2D_Init (SCE_SArray2D *a)
     a->size = 1;
     a->w = a->h = 0;
     a->x = a->y = 0;
+    a->alignment = 0;
+    a->tile_shift = 0;
+    a->tiles = NULL;
+    a->n_tiles = a->tiles_size = 0;
+    a->min_x = a->min_y = 0;
+    a->max_x = a->max_y = -1;
 }
+static void SCE_Array2D_ClearTiles (SCE_SArray2D*);
 void SCE_Array2D_Clear (SCE_SArray2D *a)
 {
-    SCE_free (a->ptr);
+    if (a->alignment)
+        SCE_free_aligned (a->ptr);
+    else
+        SCE_free (a->ptr);
+    SCE_Array2D_ClearTiles (a);
     SCE_free (a->empty_pattern);
 }
 
@@ -56,6 +68,216 @@ int SCE_Array2D_SetEmptyPattern (SCE_SArray2D *a, const void *pattern)
     return SCE_OK;
 }
 
+/**
+ * \brief Sets the alignment of the storage of a 2D array
+ * \param align alignment in bytes, must be a power of two, 0 means the one
+ * of SCE_malloc()
+ *
+ * Must be called before any element is set.
+ */
+void SCE_Array2D_SetAlignment (SCE_SArray2D *a, size_t align)
+{
+    a->alignment = align;
+}
+
+/**
+ * \brief Makes a 2D array store its elements in square tiles
+ * \param shift log2 of the side of a tile, in elements, 0 to use a single
+ * dense grid (the default)
+ *
+ * A tiled array only allocates the tiles where elements are set, and
+ * growing it never moves the existing elements. SCE_Array2D_Get() succeeds
+ * inside the bounding box of the elements that were set, the elements that
+ * were never set read as the empty pattern (or zeroes if there is none).
+ * Must be called before any element is set.
+ * \sa SCE_ARRAY2D_DEFAULT_TILE_SHIFT
+ */
+void SCE_Array2D_SetTiled (SCE_SArray2D *a, unsigned int shift)
+{
+    a->tile_shift = shift;
+}
+
+/**
+ * \brief Gets the number of tiles allocated by a tiled 2D array
+ */
+size_t SCE_Array2D_GetNumTiles (const SCE_SArray2D *a)
+{
+    return a->n_tiles;
+}
+
+
+/* tiled storage */
+
+/* coordinates of the tile containing the element \p x */
+#define SCE_Array2D_TileCoord(a, x) SCE_ArrayBlock_Coord (x, (a)->tile_shift)
+#define SCE_Array2D_TileSide(a) ((size_t)1 << (a)->tile_shift)
+
+static void SCE_Array2D_ClearTiles (SCE_SArray2D *a)
+{
+    size_t i;
+    for (i = 0; i < a->tiles_size; i++) {
+        SCE_SArray2DTile *t = a->tiles[i], *next = NULL;
+        while (t) {
+            next = t->next;
+            SCE_ArrayBlock_Delete (t, a->alignment);
+            t = next;
+        }
+    }
+    SCE_free (a->tiles);
+    a->tiles = NULL;
+    a->n_tiles = a->tiles_size = 0;
+}
+
+static SCE_SArray2DTile* SCE_Array2D_FindTile (SCE_SArray2D *a, long x, long y)
+{
+    long p[3];
+    p[0] = x; p[1] = y; p[2] = 0;
+    return SCE_ArrayBlock_Find (a->tiles, a->tiles_size, p);
+}
+
+static SCE_SArray2DTile* SCE_Array2D_CreateTile (SCE_SArray2D *a,
+                                                 long x, long y)
+{
+    SCE_SArray2DTile *t = NULL;
+    size_t side = SCE_Array2D_TileSide (a);
+
+    if (!(t = SCE_ArrayBlock_New (side * side, a->size, a->alignment,
+                                  a->empty_pattern)))
+        goto fail;
+    t->p[0] = x;
+    t->p[1] = y;
+    if (SCE_ArrayBlock_Insert (&a->tiles, &a->tiles_size, a->n_tiles, t) < 0) {
+        SCE_ArrayBlock_Delete (t, a->alignment);
+        goto fail;
+    }
+    a->n_tiles++;
+    return t;
+fail:
+    SCEE_LogSrc ();
+    return NULL;
+}
+
+/* address of the element \p x, \p y in its tile \p t */
+static char* SCE_Array2D_GetTileElement (SCE_SArray2D *a,
+                                         SCE_SArray2DTile *t, long x, long y)
+{
+    size_t u = x - (t->p[0] << a->tile_shift);
+    size_t v = y - (t->p[1] << a->tile_shift);
+    return &t->ptr[((v << a->tile_shift) + u) * a->size];
+}
+
+/* grows the bounding box of the set elements to include the given one */
+static void SCE_Array2D_ExtendBBox (SCE_SArray2D *a, long x1, long y1,
+                                    long x2, long y2)
+{
+    if (a->min_x > a->max_x) {
+        a->min_x = x1; a->max_x = x2;
+        a->min_y = y1; a->max_y = y2;
+    } else {
+        a->min_x = MIN (a->min_x, x1);
+        a->max_x = MAX (a->max_x, x2);
+        a->min_y = MIN (a->min_y, y1);
+        a->max_y = MAX (a->max_y, y2);
+    }
+}
+
+/* address of the element \p x, \p y in its tile, \p n receives the number
+   of elements left in the row of the tile. Returns NULL if the tile doesn't
+   exist and \p create is false, or on error */
+static char* SCE_Array2D_GetTileSpan (SCE_SArray2D *a, long x, long y,
+                                      int create, size_t *n)
+{
+    long tx = SCE_Array2D_TileCoord (a, x);
+    long ty = SCE_Array2D_TileCoord (a, y);
+    SCE_SArray2DTile *t = NULL;
+
+    *n = SCE_Array2D_TileSide (a) - (size_t)(x - (tx << a->tile_shift));
+    if (!(t = SCE_Array2D_FindTile (a, tx, ty)) && create &&
+        !(t = SCE_Array2D_CreateTile (a, tx, ty)))
+        SCEE_LogSrc ();
+    return t ? SCE_Array2D_GetTileElement (a, t, x, y) : NULL;
+}
+
+static int SCE_Array2D_SetTiledRow (SCE_SArray2D *a, long x, long y, size_t n,
+                                    const char *data, int fill)
+{
+    size_t k, left = n;
+    char *p = NULL;
+
+    while (left) {
+        if (!(p = SCE_Array2D_GetTileSpan (a, x, y, SCE_TRUE, &k))) {
+            SCEE_LogSrc ();
+            return SCE_ERROR;
+        }
+        k = MIN (k, left);
+        if (fill)
+            SCE_ArrayBlock_Replicate (p, data, a->size, k);
+        else {
+            memcpy (p, data, k * a->size);
+            data += k * a->size;
+        }
+        x += k;
+        left -= k;
+    }
+    return SCE_OK;
+}
+
+static void SCE_Array2D_GetTiledRow (SCE_SArray2D *a, long x, long y, size_t n,
+                                     char *data)
+{
+    size_t k;
+    char *p = NULL;
+
+    while (n) {
+        p = SCE_Array2D_GetTileSpan (a, x, y, SCE_FALSE, &k);
+        k = MIN (k, n);
+        if (p)
+            memcpy (data, p, k * a->size);
+        else
+            SCE_ArrayBlock_FillEmpty (data, a->empty_pattern, a->size, k);
+        data += k * a->size;
+        x += k;
+        n -= k;
+    }
+}
+
+static int SCE_Array2D_SetTiledElement (SCE_SArray2D *a, long x, long y,
+                                        void *data)
+{
+    long tx = SCE_Array2D_TileCoord (a, x);
+    long ty = SCE_Array2D_TileCoord (a, y);
+    SCE_SArray2DTile *t = NULL;
+
+    if (!(t = SCE_Array2D_FindTile (a, tx, ty)) &&
+        !(t = SCE_Array2D_CreateTile (a, tx, ty))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memcpy (SCE_Array2D_GetTileElement (a, t, x, y), data, a->size);
+    SCE_Array2D_ExtendBBox (a, x, y, x, y);
+    return SCE_OK;
+}
+
+static int SCE_Array2D_GetTiledElement (SCE_SArray2D *a, long x, long y,
+                                        void *data)
+{
+    SCE_SArray2DTile *t = NULL;
+
+    if (x < a->min_x || x > a->max_x || y < a->min_y || y > a->max_y)
+        return SCE_FALSE;
+
+    t = SCE_Array2D_FindTile (a, SCE_Array2D_TileCoord (a, x),
+                              SCE_Array2D_TileCoord (a, y));
+    if (t)
+        memcpy (data, SCE_Array2D_GetTileElement (a, t, x, y), a->size);
+    else
+        SCE_ArrayBlock_FillEmpty (data, a->empty_pattern, a->size, 1);
+    return SCE_TRUE;
+}
+
+
+/* dense storage */
+
 static int SCE_Array2D_IsPointAllocated (SCE_SArray2D *a, long x, long y)
 {
     long u, v;
@@ -73,22 +295,24 @@ static size_t xoffset (SCE_SArray2D *a, long x, long y)
     return (y * a->w + x) * a->size;
 }
 
-static int SCE_Array2D_Realloc (SCE_SArray2D *a, long x, long y,
+/* the new grid must contain the old one */
+static int SCE_Array2D_Realloc (SCE_SArray2D *a, size_t x, size_t y,
                                 size_t w, size_t h)
 {
     SCE_SArray2D tmp;
-    char *new = NULL;
-    size_t i, j;
+    char *new = NULL, *row = NULL;
+    size_t j, dx, dy;
+    size_t row_size = w * a->size, old_row_size = a->w * a->size;
 
-    if (!(new = SCE_malloc (w * h * a->size))) {
+    if (a->alignment)
+        new = SCE_malloc_aligned (a->alignment, w * h * a->size);
+    else
+        new = SCE_malloc (w * h * a->size);
+    if (!new) {
         SCEE_LogSrc ();
         return SCE_ERROR;
     }
 
-    /* fillup with empty pattern */
-    for (i = 0; i < w * h; i++)
-        memcpy (&new[i * a->size], a->empty_pattern, a->size);
-
     tmp = *a;
 
     a->ptr = new;
@@ -97,54 +321,78 @@ static int SCE_Array2D_Realloc (SCE_SArray2D *a, long x, long y,
     a->w = w;
     a->h = h;
 
-    for (i = 0; i < w; i++) {
-        for (j = 0; j < h; j++) {
-            x = i - a->x;
-            y = j - a->y;
+    /* position of the old grid in the new one */
+    dx = x - tmp.x;
+    dy = y - tmp.y;
 
-            if (SCE_Array2D_IsPointAllocated (&tmp, x, y))
-                memcpy ( &a->ptr[xoffset (   a, x, y)],
-                        &tmp.ptr[xoffset (&tmp, x, y)], a->size);
+    for (j = 0; j < h; j++) {
+        row = &new[j * row_size];
+        if (j < dy || j >= dy + tmp.h) {
+            /* the first empty row is built, the other ones copied */
+            if (j > 0 && (j - 1 < dy || j - 1 >= dy + tmp.h))
+                memcpy (row, row - row_size, row_size);
+            else
+                SCE_ArrayBlock_FillEmpty (row, a->empty_pattern, a->size, w);
+        } else {
+            SCE_ArrayBlock_FillEmpty (row, a->empty_pattern, a->size, dx);
+            memcpy (&row[dx * a->size], &tmp.ptr[(j - dy) * old_row_size],
+                    old_row_size);
+            SCE_ArrayBlock_FillEmpty (&row[dx * a->size + old_row_size],
+                                      a->empty_pattern, a->size,
+                                      w - dx - tmp.w);
         }
     }
 
-    SCE_free (tmp.ptr);
+    if (a->alignment)
+        SCE_free_aligned (tmp.ptr);
+    else
+        SCE_free (tmp.ptr);
 
     return SCE_OK;
 }
 
-static int SCE_Array2D_Expand (SCE_SArray2D *a, long x, long y)
+/* computes the new extent of one axis so that [lo, hi) (in storage
+   coordinates) fits, at least doubling the current one \p w */
+static void SCE_Array2D_ExpandAxis (long lo, long hi, size_t w,
+                                    size_t *new_w, size_t *offset)
 {
-    size_t new_x, new_y;
-    size_t new_w, new_h;
+    long start = MIN (lo, 0), end = MAX (hi, (long)w);
 
-    x += a->x;
-    y += a->y;
-
-    new_x = a->x;
-    new_y = a->y;
-    new_w = a->w;
-    new_h = a->h;
-
-    if (x >= (long)a->w) {
-        new_w = MAX ((size_t)x + 1, 2 * a->w);
-    } else if (x < 0) {
-        new_w = MAX ((size_t)(-x) + a->w, 2 * a->w);
-        new_x = a->x + (size_t)(new_w - (long)a->w);
+    *new_w = w;
+    *offset = 0;
+    if (start < 0 || end > (long)w) {
+        *new_w = MAX ((size_t)(end - start), 2 * w);
+        /* the extra room goes on the side that grew */
+        if (start < 0)
+            *offset = *new_w - (size_t)end;
     }
+}
 
-    if (y >= (long)a->h) {
-        new_h = MAX ((size_t)y + 1, 2 * a->h);
-    } else if (y < 0) {
-        new_h = MAX ((size_t)(-y) + a->h, 2 * a->h);
-        new_y = a->y + (size_t)(new_h - (long)a->h);
-    }
+/* makes [x1, x2) x [y1, y2) allocated, growing the grid only once */
+static int SCE_Array2D_ExpandRect (SCE_SArray2D *a, long x1, long y1,
+                                   long x2, long y2)
+{
+    size_t new_w, new_h, dx, dy;
 
-    return SCE_Array2D_Realloc (a, new_x, new_y, new_w, new_h);
+    SCE_Array2D_ExpandAxis (x1 + (long)a->x, x2 + (long)a->x, a->w,
+                            &new_w, &dx);
+    SCE_Array2D_ExpandAxis (y1 + (long)a->y, y2 + (long)a->y, a->h,
+                            &new_h, &dy);
+    if (new_w == a->w && new_h == a->h)
+        return SCE_OK;
+    return SCE_Array2D_Realloc (a, a->x + dx, a->y + dy, new_w, new_h);
+}
+
+static int SCE_Array2D_Expand (SCE_SArray2D *a, long x, long y)
+{
+    return SCE_Array2D_ExpandRect (a, x, y, x + 1, y + 1);
 }
 
 int SCE_Array2D_Set (SCE_SArray2D *a, long x, long y, void *data)
 {
+    if (a->tile_shift)
+        return SCE_Array2D_SetTiledElement (a, x, y, data);
+
     if (!SCE_Array2D_IsPointAllocated (a, x, y)) {
         if (SCE_Array2D_Expand (a, x, y) < 0) {
             SCEE_LogSrc ();
@@ -163,9 +411,203 @@ int SCE_Array2D_Set (SCE_SArray2D *a, long x, long y, void *data)
  */
 int SCE_Array2D_Get (SCE_SArray2D *a, long x, long y, void *data)
 {
+    if (a->tile_shift)
+        return SCE_Array2D_GetTiledElement (a, x, y, data);
+
     if (!SCE_Array2D_IsPointAllocated (a, x, y))
         return SCE_FALSE;
 
     memcpy (data, &a->ptr[xoffset (a, x, y)], a->size);
     return SCE_TRUE;
 }
+
+
+/**
+ * \brief Makes a rectangle of a 2D array allocated
+ * \param r the rectangle, \p r->p2 is excluded
+ *
+ * Callers knowing the final extent of the array avoid the repeated
+ * reallocations of SCE_Array2D_Set(). The new elements are set to the empty
+ * pattern. Tiled arrays only allocate tiles when elements are set, this
+ * function does nothing for them.
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_Array2D_Reserve (SCE_SArray2D *a, const SCE_SIntRect *r)
+{
+    size_t x, y, w, h;
+    long x1, y1, x2, y2;
+
+    if (a->tile_shift || r->p2[0] <= r->p1[0] || r->p2[1] <= r->p1[1])
+        return SCE_OK;
+
+    /* exact fit of the union of the allocated area and r, like
+       SCE_Array2D_Expand() the grid always holds the origin */
+    x1 = MIN ((long)r->p1[0], -(long)a->x);
+    y1 = MIN ((long)r->p1[1], -(long)a->y);
+    x2 = MAX ((long)r->p2[0], (long)a->w - (long)a->x);
+    y2 = MAX ((long)r->p2[1], (long)a->h - (long)a->y);
+    w = x2 - x1;
+    h = y2 - y1;
+    x = -x1;
+    y = -y1;
+    if (w == a->w && h == a->h)
+        return SCE_OK;
+    if (SCE_Array2D_Realloc (a, x, y, w, h) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Sets \p n consecutive elements of a row
+ * \param x,y coordinates of the first element
+ * \param n number of elements
+ * \param data \p n packed elements
+ *
+ * The array grows at most once to hold the whole row.
+ * \sa SCE_Array2D_SetRect(), SCE_Array2D_GetRow()
+ */
+int SCE_Array2D_SetRow (SCE_SArray2D *a, long x, long y, size_t n,
+                        const void *data)
+{
+    SCE_SIntRect r;
+    SCE_Rectangle_Set (&r, x, y, x + n, y + 1);
+    if (SCE_Array2D_SetRect (a, &r, data) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Gets \p n consecutive elements of a row
+ * \param data where to store \p n packed elements
+ * \return SCE_TRUE if the whole row lies in the allocated area, SCE_FALSE
+ * otherwise, the elements outside of it are set to the empty pattern
+ * \sa SCE_Array2D_GetRect(), SCE_Array2D_SetRow()
+ */
+int SCE_Array2D_GetRow (SCE_SArray2D *a, long x, long y, size_t n, void *data)
+{
+    SCE_SIntRect r;
+    SCE_Rectangle_Set (&r, x, y, x + n, y + 1);
+    return SCE_Array2D_GetRect (a, &r, data);
+}
+
+static int SCE_Array2D_SetRectAux (SCE_SArray2D *a, const SCE_SIntRect *r,
+                                   const char *data, int fill)
+{
+    size_t w = r->p2[0] - r->p1[0];
+    size_t row = w * a->size;
+    long y;
+
+    if (r->p2[0] <= r->p1[0] || r->p2[1] <= r->p1[1])
+        return SCE_OK;
+
+    if (a->tile_shift) {
+        for (y = r->p1[1]; y < r->p2[1]; y++) {
+            if (SCE_Array2D_SetTiledRow (a, r->p1[0], y, w, data, fill) < 0)
+                goto fail;
+            if (!fill)
+                data += row;
+        }
+        SCE_Array2D_ExtendBBox (a, r->p1[0], r->p1[1],
+                                r->p2[0] - 1, r->p2[1] - 1);
+        return SCE_OK;
+    }
+
+    if (SCE_Array2D_ExpandRect (a, r->p1[0], r->p1[1], r->p2[0], r->p2[1]) < 0)
+        goto fail;
+    if (fill) {
+        /* build the first row, then copy it */
+        char *first = &a->ptr[xoffset (a, r->p1[0], r->p1[1])];
+        SCE_ArrayBlock_Replicate (first, data, a->size, w);
+        for (y = r->p1[1] + 1; y < r->p2[1]; y++)
+            memcpy (&a->ptr[xoffset (a, r->p1[0], y)], first, row);
+    } else {
+        for (y = r->p1[1]; y < r->p2[1]; y++, data += row)
+            memcpy (&a->ptr[xoffset (a, r->p1[0], y)], data, row);
+    }
+    return SCE_OK;
+fail:
+    SCEE_LogSrc ();
+    return SCE_ERROR;
+}
+
+/**
+ * \brief Sets all the elements of a rectangle
+ * \param r the rectangle, \p r->p2 is excluded
+ * \param data packed rows of elements, the first one being at \p r->p1
+ *
+ * The array grows at most once to hold the whole rectangle.
+ * \sa SCE_Array2D_GetRect(), SCE_Array2D_FillRect()
+ */
+int SCE_Array2D_SetRect (SCE_SArray2D *a, const SCE_SIntRect *r,
+                         const void *data)
+{
+    if (SCE_Array2D_SetRectAux (a, r, data, SCE_FALSE) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Sets all the elements of a rectangle to the same value
+ * \param r the rectangle, \p r->p2 is excluded
+ * \param elt the element to copy
+ * \sa SCE_Array2D_SetRect()
+ */
+int SCE_Array2D_FillRect (SCE_SArray2D *a, const SCE_SIntRect *r,
+                          const void *elt)
+{
+    if (SCE_Array2D_SetRectAux (a, r, elt, SCE_TRUE) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Gets all the elements of a rectangle
+ * \param r the rectangle, \p r->p2 is excluded
+ * \param data where to store the packed rows of elements
+ * \return SCE_TRUE if the whole rectangle lies in the allocated area,
+ * SCE_FALSE otherwise, the elements outside of it are set to the empty
+ * pattern
+ * \sa SCE_Array2D_Get(), SCE_Array2D_SetRect()
+ */
+int SCE_Array2D_GetRect (SCE_SArray2D *a, const SCE_SIntRect *r, void *data)
+{
+    size_t w = r->p2[0] - r->p1[0];
+    size_t row = w * a->size;
+    long y, x1, x2;
+    char *p = data;
+
+    if (r->p2[0] <= r->p1[0] || r->p2[1] <= r->p1[1])
+        return SCE_TRUE;
+
+    if (a->tile_shift) {
+        for (y = r->p1[1]; y < r->p2[1]; y++, p += row)
+            SCE_Array2D_GetTiledRow (a, r->p1[0], y, w, p);
+        return r->p1[0] >= a->min_x && r->p2[0] - 1 <= a->max_x &&
+               r->p1[1] >= a->min_y && r->p2[1] - 1 <= a->max_y;
+    }
+
+    /* allocated part of the rows */
+    x1 = MAX ((long)r->p1[0], -(long)a->x);
+    x2 = MIN ((long)r->p2[0], (long)a->w - (long)a->x);
+    for (y = r->p1[1]; y < r->p2[1]; y++, p += row) {
+        if (x1 >= x2 || !SCE_Array2D_IsPointAllocated (a, x1, y))
+            SCE_ArrayBlock_FillEmpty (p, a->empty_pattern, a->size, w);
+        else {
+            size_t before = x1 - r->p1[0], inside = x2 - x1;
+            SCE_ArrayBlock_FillEmpty (p, a->empty_pattern, a->size, before);
+            memcpy (&p[before * a->size], &a->ptr[xoffset (a, x1, y)],
+                    inside * a->size);
+            SCE_ArrayBlock_FillEmpty (&p[(before + inside) * a->size],
+                                      a->empty_pattern, a->size,
+                                      w - before - inside);
+        }
+    }
+    return SCE_Array2D_IsPointAllocated (a, r->p1[0], r->p1[1]) &&
+           SCE_Array2D_IsPointAllocated (a, r->p2[0] - 1, r->p2[1] - 1);
+}
@@ -0,0 +1,442 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <string.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEArray3D.h"
+#include "SCEArrayBlock.h"
+
+/**
+ * \file SCEArray3D.c
+ * \copydoc array3d
+ * \brief Sparse 3D arrays
+ *
+ * \file SCEArray3D.h
+ * \copydoc array3d
+ * \brief Sparse 3D arrays
+ */
+
+/**
+ * \defgroup array3d Sparse 3D arrays
+ * \ingroup utils
+ *
+ * A 3D array of elements addressed by signed coordinates, stored in cubic
+ * bricks that are only allocated where elements are set. Regions are given
+ * as SCE_SLongRect3 whose \c p2 is excluded. Elements that were never set
+ * read as the empty pattern, or zeroes if there is none.
+ */
+
+/** @{ */
+
+/* coordinate of the brick containing the element \p x */
+#define SCE_Array3D_BrickCoord(a, x)\
+    SCE_ArrayBlock_Coord (x, (a)->brick_shift)
+#define SCE_Array3D_BrickSide(a) ((size_t)1 << (a)->brick_shift)
+
+
+/**
+ * \brief Initializes a 3D array
+ */
+void SCE_Array3D_Init (SCE_SArray3D *a)
+{
+    a->empty_pattern = NULL;
+    a->size = 1;
+    a->alignment = 0;
+    a->brick_shift = SCE_ARRAY3D_DEFAULT_BRICK_SHIFT;
+    a->bricks = NULL;
+    a->n_bricks = a->bricks_size = 0;
+    a->first = NULL;
+    a->min[0] = a->min[1] = a->min[2] = 0;
+    a->max[0] = a->max[1] = a->max[2] = -1;
+}
+/**
+ * \brief Frees all the memory of a 3D array
+ */
+void SCE_Array3D_Clear (SCE_SArray3D *a)
+{
+    SCE_SArray3DBrick *b = a->first, *next = NULL;
+    while (b) {
+        next = b->all;
+        SCE_ArrayBlock_Delete (b, a->alignment);
+        b = next;
+    }
+    SCE_free (a->bricks);
+    SCE_free (a->empty_pattern);
+}
+
+/**
+ * \brief Sets the size of the elements of a 3D array, in bytes
+ *
+ * Must be called before any element is set.
+ */
+void SCE_Array3D_SetElementSize (SCE_SArray3D *a, size_t size)
+{
+    a->size = size;
+}
+/**
+ * \brief Sets the value of the elements that were never set
+ * \param pattern one element, copied
+ *
+ * Must be called after SCE_Array3D_SetElementSize() and before any element
+ * is set.
+ */
+int SCE_Array3D_SetEmptyPattern (SCE_SArray3D *a, const void *pattern)
+{
+    SCE_free (a->empty_pattern);
+    if (!(a->empty_pattern = SCE_malloc (a->size))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memcpy (a->empty_pattern, pattern, a->size);
+    return SCE_OK;
+}
+/**
+ * \brief Sets the alignment of the bricks of a 3D array
+ * \param align alignment in bytes, must be a power of two, 0 means the one
+ * of SCE_malloc()
+ *
+ * Must be called before any element is set.
+ */
+void SCE_Array3D_SetAlignment (SCE_SArray3D *a, size_t align)
+{
+    a->alignment = align;
+}
+/**
+ * \brief Sets the size of the bricks of a 3D array
+ * \param shift log2 of the side of a brick, in elements
+ *
+ * Must be called before any element is set.
+ * \sa SCE_ARRAY3D_DEFAULT_BRICK_SHIFT
+ */
+void SCE_Array3D_SetBrickShift (SCE_SArray3D *a, unsigned int shift)
+{
+    a->brick_shift = shift;
+}
+
+/**
+ * \brief Gets the number of bricks allocated by a 3D array
+ */
+size_t SCE_Array3D_GetNumBricks (const SCE_SArray3D *a)
+{
+    return a->n_bricks;
+}
+/**
+ * \brief Gets the bounding box of the elements set in a 3D array
+ * \param r where to store the bounding box, \p r->p2 is excluded
+ * \returns SCE_FALSE if no element has been set, SCE_TRUE otherwise
+ */
+int SCE_Array3D_GetBounds (const SCE_SArray3D *a, SCE_SLongRect3 *r)
+{
+    if (a->min[0] > a->max[0])
+        return SCE_FALSE;
+    SCE_Rectangle3_Setl (r, a->min[0], a->min[1], a->min[2],
+                         a->max[0] + 1, a->max[1] + 1, a->max[2] + 1);
+    return SCE_TRUE;
+}
+
+
+static SCE_SArray3DBrick* SCE_Array3D_CreateBrick (SCE_SArray3D *a,
+                                                   const long *p)
+{
+    SCE_SArray3DBrick *b = NULL;
+    size_t side = SCE_Array3D_BrickSide (a);
+
+    if (!(b = SCE_ArrayBlock_New (side * side * side, a->size, a->alignment,
+                                  a->empty_pattern)))
+        goto fail;
+    b->p[0] = p[0];
+    b->p[1] = p[1];
+    b->p[2] = p[2];
+    if (SCE_ArrayBlock_Insert (&a->bricks, &a->bricks_size, a->n_bricks,
+                               b) < 0) {
+        SCE_ArrayBlock_Delete (b, a->alignment);
+        goto fail;
+    }
+    b->all = a->first;
+    a->first = b;
+    a->n_bricks++;
+    return b;
+fail:
+    SCEE_LogSrc ();
+    return NULL;
+}
+
+/* address of the element \p x, \p y, \p z, \p n receives the number of
+   elements left in the row of its brick. Returns NULL if the brick doesn't
+   exist and \p create is false, or on error */
+static char* SCE_Array3D_GetSpan (SCE_SArray3D *a, long x, long y, long z,
+                                  int create, size_t *n)
+{
+    SCE_SArray3DBrick *b = NULL;
+    unsigned int s = a->brick_shift;
+    long p[3];
+    size_t u, v, w;
+
+    p[0] = SCE_Array3D_BrickCoord (a, x);
+    p[1] = SCE_Array3D_BrickCoord (a, y);
+    p[2] = SCE_Array3D_BrickCoord (a, z);
+    u = x - (p[0] << s);
+    v = y - (p[1] << s);
+    w = z - (p[2] << s);
+    *n = SCE_Array3D_BrickSide (a) - u;
+
+    b = SCE_ArrayBlock_Find (a->bricks, a->bricks_size, p);
+    if (!b && create && !(b = SCE_Array3D_CreateBrick (a, p)))
+        SCEE_LogSrc ();
+    if (!b)
+        return NULL;
+    return &b->ptr[((((w << s) + v) << s) + u) * a->size];
+}
+
+/* grows the bounding box of the set elements, \p p2 included */
+static void SCE_Array3D_ExtendBBox (SCE_SArray3D *a, const long *p1,
+                                    const long *p2)
+{
+    unsigned int i;
+    if (a->min[0] > a->max[0]) {
+        for (i = 0; i < 3; i++) {
+            a->min[i] = p1[i];
+            a->max[i] = p2[i];
+        }
+    } else {
+        for (i = 0; i < 3; i++) {
+            a->min[i] = MIN (a->min[i], p1[i]);
+            a->max[i] = MAX (a->max[i], p2[i]);
+        }
+    }
+}
+
+static int SCE_Array3D_IsInBBox (const SCE_SArray3D *a, const long *p1,
+                                 const long *p2)
+{
+    unsigned int i;
+    for (i = 0; i < 3; i++) {
+        if (p1[i] < a->min[i] || p2[i] > a->max[i])
+            return SCE_FALSE;
+    }
+    return SCE_TRUE;
+}
+
+
+/**
+ * \brief Sets an element of a 3D array
+ * \param data the element, copied
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_Array3D_Set (SCE_SArray3D *a, long x, long y, long z,
+                     const void *data)
+{
+    size_t n;
+    char *p = NULL;
+    long c[3];
+
+    if (!(p = SCE_Array3D_GetSpan (a, x, y, z, SCE_TRUE, &n))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    memcpy (p, data, a->size);
+    c[0] = x; c[1] = y; c[2] = z;
+    SCE_Array3D_ExtendBBox (a, c, c);
+    return SCE_OK;
+}
+/**
+ * \brief Gets an element of a 3D array
+ * \param data where to copy the element
+ * \return SCE_TRUE if the operation succeeded, SCE_FALSE if the given
+ * coordinates are outside of the bounding box of the elements set
+ */
+int SCE_Array3D_Get (SCE_SArray3D *a, long x, long y, long z, void *data)
+{
+    size_t n;
+    char *p = NULL;
+    long c[3];
+
+    c[0] = x; c[1] = y; c[2] = z;
+    if (!SCE_Array3D_IsInBBox (a, c, c))
+        return SCE_FALSE;
+    if ((p = SCE_Array3D_GetSpan (a, x, y, z, SCE_FALSE, &n)))
+        memcpy (data, p, a->size);
+    else
+        SCE_ArrayBlock_FillEmpty (data, a->empty_pattern, a->size, 1);
+    return SCE_TRUE;
+}
+
+
+static int SCE_Array3D_SetRegionAux (SCE_SArray3D *a, const SCE_SLongRect3 *r,
+                                     const char *data, int fill)
+{
+    size_t w = r->p2[0] - r->p1[0];
+    size_t k, left;
+    long x, y, z, last[3];
+    char *p = NULL;
+
+    if (SCE_Rectangle3_GetWidthl (r) <= 0 ||
+        SCE_Rectangle3_GetHeightl (r) <= 0 ||
+        SCE_Rectangle3_GetDepthl (r) <= 0)
+        return SCE_OK;
+
+    for (z = r->p1[2]; z < r->p2[2]; z++) {
+        for (y = r->p1[1]; y < r->p2[1]; y++) {
+            x = r->p1[0];
+            left = w;
+            while (left) {
+                if (!(p = SCE_Array3D_GetSpan (a, x, y, z, SCE_TRUE, &k))) {
+                    SCEE_LogSrc ();
+                    return SCE_ERROR;
+                }
+                k = MIN (k, left);
+                if (fill)
+                    SCE_ArrayBlock_Replicate (p, data, a->size, k);
+                else {
+                    memcpy (p, data, k * a->size);
+                    data += k * a->size;
+                }
+                x += k;
+                left -= k;
+            }
+        }
+    }
+    last[0] = r->p2[0] - 1;
+    last[1] = r->p2[1] - 1;
+    last[2] = r->p2[2] - 1;
+    SCE_Array3D_ExtendBBox (a, r->p1, last);
+    return SCE_OK;
+}
+
+/**
+ * \brief Sets all the elements of a region
+ * \param r the region, \p r->p2 is excluded
+ * \param data packed elements, x varying first, then y, then z
+ * \sa SCE_Array3D_GetRegion(), SCE_Array3D_FillRegion()
+ */
+int SCE_Array3D_SetRegion (SCE_SArray3D *a, const SCE_SLongRect3 *r,
+                           const void *data)
+{
+    if (SCE_Array3D_SetRegionAux (a, r, data, SCE_FALSE) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Sets all the elements of a region to the same value
+ * \param r the region, \p r->p2 is excluded
+ * \param elt the element to copy
+ * \sa SCE_Array3D_SetRegion()
+ */
+int SCE_Array3D_FillRegion (SCE_SArray3D *a, const SCE_SLongRect3 *r,
+                            const void *elt)
+{
+    if (SCE_Array3D_SetRegionAux (a, r, elt, SCE_TRUE) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Gets all the elements of a region
+ * \param r the region, \p r->p2 is excluded
+ * \param data where to store the packed elements, x varying first
+ * \return SCE_TRUE if the region lies in the bounding box of the elements
+ * set, SCE_FALSE otherwise; the elements never set are read as the empty
+ * pattern in both cases
+ * \sa SCE_Array3D_SetRegion()
+ */
+int SCE_Array3D_GetRegion (SCE_SArray3D *a, const SCE_SLongRect3 *r,
+                           void *data)
+{
+    size_t w = r->p2[0] - r->p1[0];
+    size_t k, left;
+    long x, y, z, last[3];
+    char *p = NULL, *dst = data;
+
+    if (SCE_Rectangle3_GetWidthl (r) <= 0 ||
+        SCE_Rectangle3_GetHeightl (r) <= 0 ||
+        SCE_Rectangle3_GetDepthl (r) <= 0)
+        return SCE_TRUE;
+
+    for (z = r->p1[2]; z < r->p2[2]; z++) {
+        for (y = r->p1[1]; y < r->p2[1]; y++) {
+            x = r->p1[0];
+            left = w;
+            while (left) {
+                p = SCE_Array3D_GetSpan (a, x, y, z, SCE_FALSE, &k);
+                k = MIN (k, left);
+                if (p)
+                    memcpy (dst, p, k * a->size);
+                else
+                    SCE_ArrayBlock_FillEmpty (dst, a->empty_pattern,
+                                              a->size, k);
+                dst += k * a->size;
+                x += k;
+                left -= k;
+            }
+        }
+    }
+    last[0] = r->p2[0] - 1;
+    last[1] = r->p2[1] - 1;
+    last[2] = r->p2[2] - 1;
+    return SCE_Array3D_IsInBBox (a, r->p1, last);
+}
+
+
+/**
+ * \brief Gets the first allocated brick of a 3D array
+ * \returns NULL if the array has no brick
+ * \sa SCE_Array3D_ForEachBrick()
+ */
+SCE_SArray3DBrick* SCE_Array3D_GetFirstBrick (SCE_SArray3D *a)
+{
+    return a->first;
+}
+/**
+ * \brief Gets the brick following \p b
+ * \returns NULL if \p b is the last brick
+ */
+SCE_SArray3DBrick* SCE_Array3D_GetNextBrick (SCE_SArray3DBrick *b)
+{
+    return b->all;
+}
+/**
+ * \brief Gets the region covered by a brick
+ * \param r where to store the region, \p r->p2 is excluded
+ */
+void SCE_Array3D_GetBrickRegion (const SCE_SArray3D *a,
+                                 const SCE_SArray3DBrick *b, SCE_SLongRect3 *r)
+{
+    long side = SCE_Array3D_BrickSide (a);
+    SCE_Rectangle3_SetFromOriginl (r, b->p[0] * side, b->p[1] * side,
+                                   b->p[2] * side, side, side, side);
+}
+/**
+ * \brief Gets the elements of a brick
+ *
+ * The elements are packed, x varying first, then y, then z, and every side
+ * of the brick is 1 << SCE_SArray3D::brick_shift elements long.
+ */
+void* SCE_Array3D_GetBrickData (SCE_SArray3DBrick *b)
+{
+    return b->ptr;
+}
+
+/** @} */
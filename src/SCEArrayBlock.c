@@ -0,0 +1,150 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <string.h>
+#include "SCE/utils/SCEMath.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCEArrayBlock.h"
+
+/* copies the element \p elt of \p size bytes \p n times into \p ptr,
+   doubling the copied area at each step */
+void SCE_ArrayBlock_Replicate (char *ptr, const void *elt, size_t size,
+                               size_t n)
+{
+    size_t done, total = n * size;
+    if (!n)
+        return;
+    memcpy (ptr, elt, size);
+    for (done = size; done < total; done *= 2)
+        memcpy (&ptr[done], ptr, MIN (done, total - done));
+}
+
+/* fills \p n elements with \p pattern, or zeroes if it is NULL */
+void SCE_ArrayBlock_FillEmpty (char *ptr, const void *pattern, size_t size,
+                               size_t n)
+{
+    if (!pattern)
+        memset (ptr, 0, n * size);
+    else
+        SCE_ArrayBlock_Replicate (ptr, pattern, size, n);
+}
+
+/* creates a block of \p n elements of \p size bytes aligned on \p align
+   (0 for SCE_malloc()'s) and filled with \p pattern, its coordinates and
+   links are left to the caller */
+SCE_SArrayBlock* SCE_ArrayBlock_New (size_t n, size_t size, size_t align,
+                                     const void *pattern)
+{
+    SCE_SArrayBlock *b = NULL;
+
+    if (!(b = SCE_malloc (sizeof *b)))
+        goto fail;
+    if (align)
+        b->ptr = SCE_malloc_aligned (align, n * size);
+    else
+        b->ptr = SCE_malloc (n * size);
+    if (!b->ptr) {
+        SCE_free (b);
+        goto fail;
+    }
+    SCE_ArrayBlock_FillEmpty (b->ptr, pattern, size, n);
+    b->p[0] = b->p[1] = b->p[2] = 0;
+    b->next = b->all = NULL;
+    return b;
+fail:
+    SCEE_LogSrc ();
+    return NULL;
+}
+void SCE_ArrayBlock_Delete (SCE_SArrayBlock *b, size_t align)
+{
+    if (align)
+        SCE_free_aligned (b->ptr);
+    else
+        SCE_free (b->ptr);
+    SCE_free (b);
+}
+
+static size_t SCE_ArrayBlock_Hash (const long *p, size_t size)
+{
+    size_t h = (size_t)p[0] * 73856093u ^ (size_t)p[1] * 19349663u ^
+        (size_t)p[2] * 83492791u;
+    h ^= h >> 16;
+    return h & (size - 1);
+}
+
+/* looks for the block at \p p in the hash table \p hash of \p size
+   buckets */
+SCE_SArrayBlock* SCE_ArrayBlock_Find (SCE_SArrayBlock **hash, size_t size,
+                                      const long *p)
+{
+    SCE_SArrayBlock *b = NULL;
+    if (size) {
+        b = hash[SCE_ArrayBlock_Hash (p, size)];
+        while (b && (b->p[0] != p[0] || b->p[1] != p[1] || b->p[2] != p[2]))
+            b = b->next;
+    }
+    return b;
+}
+
+static int SCE_ArrayBlock_GrowHash (SCE_SArrayBlock ***hash, size_t *size)
+{
+    SCE_SArrayBlock **buckets = NULL;
+    size_t i, h, new_size;
+
+    new_size = *size ? *size * 2 : SCE_ARRAYBLOCK_HASH_SIZE;
+    if (!(buckets = SCE_calloc (new_size, sizeof *buckets))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    for (i = 0; i < *size; i++) {
+        SCE_SArrayBlock *b = (*hash)[i], *next = NULL;
+        while (b) {
+            h = SCE_ArrayBlock_Hash (b->p, new_size);
+            next = b->next;
+            b->next = buckets[h];
+            buckets[h] = b;
+            b = next;
+        }
+    }
+    SCE_free (*hash);
+    *hash = buckets;
+    *size = new_size;
+    return SCE_OK;
+}
+
+/* adds \p b to the hash table \p hash of \p size buckets holding
+   \p n_blocks blocks, the table grows to keep one block per bucket at
+   most on average */
+int SCE_ArrayBlock_Insert (SCE_SArrayBlock ***hash, size_t *size,
+                           size_t n_blocks, SCE_SArrayBlock *b)
+{
+    size_t h;
+
+    if (n_blocks >= *size && SCE_ArrayBlock_GrowHash (hash, size) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    h = SCE_ArrayBlock_Hash (b->p, *size);
+    b->next = (*hash)[h];
+    (*hash)[h] = b;
+    return SCE_OK;
+}
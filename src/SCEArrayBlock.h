@@ -0,0 +1,59 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+/* blocks of elements shared by the sparse storages of SCEArray2D.c (tiles)
+   and SCEArray3D.c (bricks), not installed */
+
+#ifndef SCEARRAYBLOCK_H
+#define SCEARRAYBLOCK_H
+
+#include <stddef.h>
+
+/* initial number of buckets of the hash tables of blocks, must be a power
+   of two */
+#define SCE_ARRAYBLOCK_HASH_SIZE 64
+
+/* coordinate of the block containing the element \p x, rounded toward
+   minus infinity */
+#define SCE_ArrayBlock_Coord(x, shift)\
+    ((x) >= 0 ? (x) >> (shift) : -((-(x) - 1) >> (shift)) - 1)
+
+/* SCE_SArray2DTile and SCE_SArray3DBrick */
+typedef struct sce_sarrayblock SCE_SArrayBlock;
+struct sce_sarrayblock {
+    long p[3];                  /* coordinates of the block, in blocks, the
+                                   unused ones are 0 */
+    char *ptr;
+    SCE_SArrayBlock *next;      /* next block in the same hash bucket */
+    SCE_SArrayBlock *all;       /* next block in the chain of all blocks */
+};
+
+void SCE_ArrayBlock_Replicate (char*, const void*, size_t, size_t);
+void SCE_ArrayBlock_FillEmpty (char*, const void*, size_t, size_t);
+
+SCE_SArrayBlock* SCE_ArrayBlock_New (size_t, size_t, size_t, const void*);
+void SCE_ArrayBlock_Delete (SCE_SArrayBlock*, size_t);
+
+SCE_SArrayBlock* SCE_ArrayBlock_Find (SCE_SArrayBlock**, size_t, const long*);
+int SCE_ArrayBlock_Insert (SCE_SArrayBlock***, size_t*, size_t,
+                           SCE_SArrayBlock*);
+
+#endif /* guard */
@@ -0,0 +1,151 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <stdlib.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEAtomicList.h"
+
+/**
+ * \file SCEAtomicList.c
+ * \copydoc atomiclist
+ * \brief Lock-free queues of list iterators
+ *
+ * \file SCEAtomicList.h
+ * \copydoc atomiclist
+ * \brief Lock-free queues of list iterators
+ */
+
+/**
+ * \defgroup atomiclist Lock-free queues of list iterators
+ * \ingroup utils
+ *
+ * An atomic list is a FIFO queue that any number of threads push into
+ * without locking, while a single thread pops from it. The nodes are plain
+ * SCE_SListIterator, so structures embedding an iterator can be queued
+ * without allocation and moved to a SCE_SList once popped. Only the \c next
+ * field of a queued iterator is used; an iterator can't be in a list and
+ * in an atomic list at the same time.
+ *
+ * This is Dmitry Vyukov's intrusive MPSC queue: a push is one atomic
+ * exchange, a pop is wait-free but can return NULL while a push is in
+ * progress.
+ */
+
+/** @{ */
+
+#define SCE_AtomicList_Load(p) __atomic_load_n (p, __ATOMIC_ACQUIRE)
+#define SCE_AtomicList_Store(p, v) __atomic_store_n (p, v, __ATOMIC_RELEASE)
+
+/**
+ * \brief Initializes an atomic list
+ */
+void SCE_AtomicList_Init (SCE_SAtomicList *q)
+{
+    SCE_List_InitIt (&q->stub);
+    q->head = q->tail = &q->stub;
+}
+
+/**
+ * \brief Adds an iterator at the end of an atomic list
+ * \param it an iterator that is in no list
+ *
+ * Can be called by any thread at any time.
+ */
+void SCE_AtomicList_Push (SCE_SAtomicList *q, SCE_SListIterator *it)
+{
+    SCE_SListIterator *prev = NULL;
+    it->prev = NULL;
+    it->next = NULL;
+    prev = __atomic_exchange_n (&q->head, it, __ATOMIC_ACQ_REL);
+    /* the queue is cut between the exchange and this store, the consumer
+       sees it as shorter until then */
+    SCE_AtomicList_Store (&prev->next, it);
+}
+
+/**
+ * \brief Removes the first iterator of an atomic list
+ * \returns the iterator, or NULL if the list is empty or a push is not
+ * finished yet
+ *
+ * Must only be called by one thread at a time.
+ */
+SCE_SListIterator* SCE_AtomicList_Pop (SCE_SAtomicList *q)
+{
+    SCE_SListIterator *tail = q->tail, *next = NULL, *head = NULL;
+
+    next = SCE_AtomicList_Load (&tail->next);
+    if (tail == &q->stub) {
+        if (!next)
+            return NULL;
+        q->tail = tail = next;
+        next = SCE_AtomicList_Load (&tail->next);
+    }
+    if (next) {
+        q->tail = next;
+        tail->next = NULL;
+        return tail;
+    }
+    head = SCE_AtomicList_Load (&q->head);
+    if (tail != head)
+        return NULL;            /* a producer is between its two steps */
+
+    /* tail is the last node, put the stub behind it to take it */
+    SCE_AtomicList_Push (q, &q->stub);
+    next = SCE_AtomicList_Load (&tail->next);
+    if (next) {
+        q->tail = next;
+        tail->next = NULL;
+        return tail;
+    }
+    return NULL;
+}
+
+/**
+ * \brief Moves all the iterators of an atomic list at the end of a list
+ * \param l the list receiving the iterators
+ * \returns the number of iterators moved
+ *
+ * Must only be called by the consumer thread, see SCE_AtomicList_Pop().
+ */
+unsigned int SCE_AtomicList_PopAll (SCE_SAtomicList *q, SCE_SList *l)
+{
+    SCE_SListIterator *it = NULL;
+    unsigned int n = 0;
+    while ((it = SCE_AtomicList_Pop (q))) {
+        SCE_List_Appendl (l, it);
+        n++;
+    }
+    return n;
+}
+
+/**
+ * \brief Checks whether an atomic list has no iterator to pop
+ *
+ * Only meaningful for the consumer thread.
+ */
+int SCE_AtomicList_IsEmpty (const SCE_SAtomicList *q)
+{
+    SCE_SListIterator *tail = q->tail;
+    return tail == &q->stub && !SCE_AtomicList_Load (&tail->next) &&
+           SCE_AtomicList_Load (&q->head) == tail;
+}
+
+/** @} */
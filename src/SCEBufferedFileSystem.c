@@ -0,0 +1,463 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <string.h>
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEMath.h"  /* MIN() */
+#include "SCE/utils/SCEBufferedFileSystem.h"
+
+/**
+ * \file SCEBufferedFileSystem.c
+ * \copydoc buffs
+ * \brief Buffering file system
+ *
+ * \file SCEBufferedFileSystem.h
+ * \copydoc buffs
+ * \brief Buffering file system
+ */
+
+/**
+ * \defgroup buffs Buffering file system
+ * \ingroup utils
+ *
+ * sce_buffs stacks on top of another file system, its \c subfs (sce_cfs
+ * when NULL), and gathers the small reads and writes into big ones. To
+ * buffer a custom file system, copy sce_buffs and set its \c subfs:
+ * \code
+ * SCE_SFileSystem fs = sce_buffs;
+ * fs.subfs = &my_archive_fs;
+ * SCE_File_Open (&fp, &fs, "level.dat", SCE_FILE_READ);
+ * \endcode
+ * Pending writes are given to the sub file system when the buffer is full
+ * and by SCE_File_Flush(), SCE_File_Seek() and SCE_File_Close().
+ */
+
+/** @{ */
+
+SCE_SFileSystem sce_buffs;
+
+static size_t default_size = SCE_BUFFEREDFS_DEFAULT_BUFFER_SIZE;
+
+typedef struct xfile xfile;
+struct xfile {
+    SCE_SFile f;                /* file of the sub file system */
+    unsigned char *buf;
+    size_t size;                /* size of \c buf */
+    size_t r_pos, r_end;        /* buffered data not read yet */
+    size_t w_len;               /* buffered data not written yet */
+    int sub_mode;               /* last transfer done on the sub file */
+};
+
+#define XREADING 1
+#define XWRITING 2
+
+/* like stdio, the sub file may need a flush or a seek between a read and a
+   write, see fopen(3) */
+static size_t xsubread (xfile *file, void *data, size_t size)
+{
+    if (file->sub_mode == XWRITING)
+        SCE_File_Flush (&file->f);
+    file->sub_mode = XREADING;
+    return SCE_File_Read (data, 1, size, &file->f);
+}
+static size_t xsubwrite (xfile *file, const void *data, size_t size)
+{
+    if (file->sub_mode == XREADING)
+        SCE_File_Seek (&file->f, 0, SEEK_CUR);
+    file->sub_mode = XWRITING;
+    return SCE_File_Write (data, 1, size, &file->f);
+}
+static int xsubseek (xfile *file, long offset, int whence)
+{
+    file->sub_mode = 0;
+    return SCE_File_Seek (&file->f, offset, whence);
+}
+
+
+/* gives the pending writes to the sub file system */
+static int xflushbuf (xfile *file)
+{
+    size_t n;
+    if (!file->w_len)
+        return SCE_OK;
+    n = xsubwrite (file, file->buf, file->w_len);
+    if (n != file->w_len) {
+        /* keep what could not be written */
+        memmove (file->buf, &file->buf[n], file->w_len - n);
+        file->w_len -= n;
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("buffered data could not be written");
+        return SCE_ERROR;
+    }
+    file->w_len = 0;
+    return SCE_OK;
+}
+/* forgets the read-ahead, putting the sub file back where we are */
+static int xdrop (xfile *file)
+{
+    size_t ahead = file->r_end - file->r_pos;
+    file->r_pos = file->r_end = 0;
+    if (ahead && xsubseek (file, -(long)ahead, SEEK_CUR)) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("can't seek back the sub file");
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+static int xsync (xfile *file)
+{
+    if (file->w_len)
+        return xflushbuf (file);
+    return xdrop (file);
+}
+
+
+static void* xopen (SCE_SFileSystem *fs, const char *fname, int flags)
+{
+    xfile *file = NULL;
+
+    if (!(file = SCE_malloc (sizeof *file)))
+        goto fail;
+    SCE_File_Init (&file->f);
+    file->size = default_size;
+    file->r_pos = file->r_end = file->w_len = 0;
+    file->sub_mode = 0;
+    if (!(file->buf = SCE_malloc (MAX (file->size, 1)))) {
+        SCE_free (file);
+        goto fail;
+    }
+    if (SCE_File_Open (&file->f, fs, fname, flags) < 0) {
+        SCE_free (file->buf);
+        SCE_free (file);
+        goto fail;
+    }
+    return file;
+fail:
+    SCEE_LogSrc ();
+    return NULL;
+}
+
+static int xclose (void *fd)
+{
+    int r = 0;
+    xfile *file = fd;
+    if (xflushbuf (file) < 0) {
+        SCEE_LogSrc ();
+        r = EOF;
+    }
+    if (SCE_File_Close (&file->f))
+        r = EOF;
+    SCE_free (file->buf);
+    SCE_free (file);
+    return r;
+}
+
+static size_t xread (void *data, size_t size, size_t nmemb, void *fd)
+{
+    size_t total = size * nmemb, done = 0, s;
+    unsigned char *ptr = data;
+    xfile *file = fd;
+
+    if (!total || xflushbuf (file) < 0)
+        return 0;
+
+    while (done < total) {
+        s = file->r_end - file->r_pos;
+        if (s) {
+            s = MIN (s, total - done);
+            memcpy (&ptr[done], &file->buf[file->r_pos], s);
+            file->r_pos += s;
+            done += s;
+            continue;
+        }
+        file->r_pos = file->r_end = 0;
+        /* big reads don't need to go through the buffer */
+        if (total - done >= file->size) {
+            done += xsubread (file, &ptr[done], total - done);
+            break;
+        }
+        if (!(s = xsubread (file, file->buf, file->size)))
+            break;
+        file->r_end = s;
+    }
+
+    return done / size;
+}
+
+static size_t xwrite (const void *data, size_t size, size_t nmemb, void *fd)
+{
+    size_t total = size * nmemb;
+    xfile *file = fd;
+
+    if (!total || xdrop (file) < 0)
+        return 0;
+
+    if (total > file->size - file->w_len) {
+        if (xflushbuf (file) < 0)
+            return 0;
+    }
+    if (total >= file->size)
+        return xsubwrite (file, data, total) / size;
+
+    memcpy (&file->buf[file->w_len], data, total);
+    file->w_len += total;
+    return nmemb;
+}
+
+static long xtell (void *fd)
+{
+    xfile *file = fd;
+    return SCE_File_Tell (&file->f) - (long)(file->r_end - file->r_pos)
+        + (long)file->w_len;
+}
+
+static int xseek (void *fd, long offset, int whence)
+{
+    long base;
+    xfile *file = fd;
+
+    if (whence == SEEK_CUR) {
+        offset += xtell (file);
+        whence = SEEK_SET;
+    }
+    /* short seeks inside the read-ahead don't touch the sub file */
+    if (whence == SEEK_SET && file->r_end) {
+        base = SCE_File_Tell (&file->f) - (long)file->r_end;
+        if (offset >= base && offset <= base + (long)file->r_end) {
+            file->r_pos = offset - base;
+            return 0;
+        }
+    }
+    if (xsync (file) < 0) {
+        SCEE_LogSrc ();
+        return -1;
+    }
+    return xsubseek (file, offset, whence);
+}
+
+static void xrewind (void *fd)
+{
+    xseek (fd, 0, SEEK_SET);
+}
+
+static int xflush (void *fd)
+{
+    xfile *file = fd;
+    if (xflushbuf (file) < 0) {
+        SCEE_LogSrc ();
+        return EOF;
+    }
+    file->sub_mode = 0;
+    return SCE_File_Flush (&file->f);
+}
+
+static int xtruncate (SCE_SFile *fp, size_t size)
+{
+    xfile *file = SCE_File_Get (fp);
+    if (xsync (file) < 0 || SCE_File_Truncate (&file->f, size) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+static size_t xlength (const void *fd)
+{
+    xfile *file = (xfile*)fd;
+    /* pending writes may make the file longer */
+    xflushbuf (file);
+    return SCE_File_Length (&file->f);
+}
+
+static const void* xmap (void *fd, size_t *size)
+{
+    const void *p = NULL;
+    xfile *file = fd;
+    if (xflushbuf (file) < 0 || !(p = SCE_File_Map (&file->f, size)))
+        SCEE_LogSrc ();
+    return p;
+}
+static void xunmap (void *fd, const void *p, size_t size)
+{
+    xfile *file = fd;
+    SCE_File_Unmap (&file->f, p, size);
+}
+
+static size_t xpread (void *data, size_t size, size_t nmemb, long offset,
+                      void *fd)
+{
+    xfile *file = fd;
+    if (xflushbuf (file) < 0)
+        return 0;
+    return SCE_File_ReadAt (data, size, nmemb, offset, &file->f);
+}
+static size_t xpwrite (const void *data, size_t size, size_t nmemb,
+                       long offset, void *fd)
+{
+    xfile *file = fd;
+    /* the read-ahead could become stale */
+    if (xsync (file) < 0)
+        return 0;
+    return SCE_File_WriteAt (data, size, nmemb, offset, &file->f);
+}
+
+
+int SCE_Init_BufferedFS (void)
+{
+    sce_buffs.udata = NULL;
+    sce_buffs.subfs = NULL;
+    sce_buffs.xinit = NULL;
+    sce_buffs.xopen = xopen;
+    sce_buffs.xclose = xclose;
+    sce_buffs.xread = xread;
+    sce_buffs.xwrite = xwrite;
+    sce_buffs.xseek = xseek;
+    sce_buffs.xtell = xtell;
+    sce_buffs.xrewind = xrewind;
+    sce_buffs.xflush = xflush;
+    sce_buffs.xtruncate = xtruncate;
+    sce_buffs.xlength = xlength;
+    sce_buffs.xmap = xmap;
+    sce_buffs.xunmap = xunmap;
+    sce_buffs.xpread = xpread;
+    sce_buffs.xpwrite = xpwrite;
+    /* the generic loop over xread() and xwrite() is buffered already */
+    sce_buffs.xreadv = NULL;
+    sce_buffs.xwritev = NULL;
+    return SCE_OK;
+}
+void SCE_Quit_BufferedFS (void)
+{
+}
+
+
+/**
+ * \brief Sets the size of the buffer of the files opened afterward
+ * \param size size of the buffer, in bytes, 0 disables buffering
+ * \sa SCE_BufferedFS_SetBufferSize()
+ */
+void SCE_BufferedFS_SetDefaultBufferSize (size_t size)
+{
+    default_size = size;
+}
+/**
+ * \brief Gets the size of the buffer of newly opened files
+ */
+size_t SCE_BufferedFS_GetDefaultBufferSize (void)
+{
+    return default_size;
+}
+
+/**
+ * \brief Sets the size of the buffer of a file opened with sce_buffs
+ * \param size size of the buffer, in bytes, 0 disables buffering
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * Pending writes are flushed and the read-ahead is dropped.
+ */
+int SCE_BufferedFS_SetBufferSize (SCE_SFile *fp, size_t size)
+{
+    unsigned char *buf = NULL;
+    xfile *file = SCE_File_Get (fp);
+
+    if (xsync (file) < 0)
+        goto fail;
+    if (!(buf = SCE_realloc (file->buf, MAX (size, 1))))
+        goto fail;
+    file->buf = buf;
+    file->size = size;
+    return SCE_OK;
+fail:
+    SCEE_LogSrc ();
+    return SCE_ERROR;
+}
+/**
+ * \brief Gets the size of the buffer of a file opened with sce_buffs
+ */
+size_t SCE_BufferedFS_GetBufferSize (SCE_SFile *fp)
+{
+    xfile *file = SCE_File_Get (fp);
+    return file->size;
+}
+
+/**
+ * \brief Reads data from a file without moving its position
+ * \param data where to copy the data
+ * \param size number of bytes wanted, no more than the size of the buffer
+ * of the file can be peeked
+ * \returns the number of bytes copied into \p data, less than \p size at
+ * the end of the file
+ * \sa SCE_BufferedFS_Unread()
+ */
+size_t SCE_BufferedFS_Peek (SCE_SFile *fp, void *data, size_t size)
+{
+    size_t n;
+    xfile *file = SCE_File_Get (fp);
+
+    if (xflushbuf (file) < 0) {
+        SCEE_LogSrc ();
+        return 0;
+    }
+    size = MIN (size, file->size);
+    if (file->r_end - file->r_pos < size) {
+        /* move the read-ahead to the front and fill the buffer */
+        file->r_end -= file->r_pos;
+        memmove (file->buf, &file->buf[file->r_pos], file->r_end);
+        file->r_pos = 0;
+        while (file->r_end < size) {
+            n = xsubread (file, &file->buf[file->r_end],
+                          file->size - file->r_end);
+            if (!n)
+                break;
+            file->r_end += n;
+        }
+    }
+    size = MIN (size, file->r_end - file->r_pos);
+    memcpy (data, &file->buf[file->r_pos], size);
+    return size;
+}
+
+/**
+ * \brief Steps back over bytes previously read from a file
+ * \param size number of bytes to step back
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * Bytes that are still in the buffer are given back for free, otherwise
+ * the sub file is seeked.
+ * \sa SCE_BufferedFS_Peek()
+ */
+int SCE_BufferedFS_Unread (SCE_SFile *fp, size_t size)
+{
+    xfile *file = SCE_File_Get (fp);
+
+    if (!file->w_len && size <= file->r_pos) {
+        file->r_pos -= size;
+        return SCE_OK;
+    }
+    if (xseek (file, -(long)size, SEEK_CUR)) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/** @} */
@@ -0,0 +1,330 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <string.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEMath.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEDynVector.h"
+
+/**
+ * \file SCEDynVector.c
+ * \copydoc vector
+ * \brief Dynamic arrays of elements
+ *
+ * \file SCEDynVector.h
+ * \copydoc vector
+ * \brief Dynamic arrays of elements
+ */
+
+/**
+ * \defgroup vector Dynamic arrays of elements
+ * \ingroup utils
+ *
+ * A vector keeps fixed size elements in one contiguous buffer. Appending is
+ * amortized O(1), indexing is O(1) and iterating walks memory linearly,
+ * which makes it a better fit than SCE_SList for collections that are
+ * mostly appended to and iterated over. By default the elements are
+ * pointers, see SCE_Vector_AppendPtr() and SCE_Vector_GetPtr().
+ */
+
+/** @{ */
+
+/**
+ * \brief Initializes a vector of pointers
+ * \sa SCE_Vector_SetElementSize()
+ */
+void SCE_Vector_Init (SCE_SVector *v)
+{
+    v->data = NULL;
+    v->elt_size = sizeof (void*);
+    v->n = 0;
+    v->capacity = 0;
+}
+/**
+ * \brief Frees the storage of a vector
+ */
+void SCE_Vector_Clear (SCE_SVector *v)
+{
+    SCE_free (v->data);
+    v->data = NULL;
+    v->n = v->capacity = 0;
+}
+/**
+ * \brief Removes all the elements of a vector, keeping its storage
+ */
+void SCE_Vector_Flush (SCE_SVector *v)
+{
+    v->n = 0;
+}
+
+/**
+ * \brief Sets the size of the elements of a vector, in bytes
+ *
+ * Must be called while the vector is empty.
+ */
+void SCE_Vector_SetElementSize (SCE_SVector *v, size_t size)
+{
+    v->elt_size = size;
+}
+
+static int SCE_Vector_Realloc (SCE_SVector *v, size_t capacity)
+{
+    unsigned char *data = NULL;
+
+    if (capacity && v->elt_size > (size_t)-1 / capacity) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return SCE_ERROR;
+    }
+    if (!capacity) {
+        SCE_Vector_Clear (v);
+        return SCE_OK;
+    }
+    if (!(data = SCE_realloc (v->data, capacity * v->elt_size))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    v->data = data;
+    v->capacity = capacity;
+    return SCE_OK;
+}
+
+/**
+ * \brief Makes sure a vector can hold \p n elements without reallocating
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_Vector_Reserve (SCE_SVector *v, size_t n)
+{
+    if (n <= v->capacity)
+        return SCE_OK;
+    if (SCE_Vector_Realloc (v, n) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Gives back the unused storage of a vector
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_Vector_ShrinkToFit (SCE_SVector *v)
+{
+    if (v->n == v->capacity)
+        return SCE_OK;
+    if (SCE_Vector_Realloc (v, v->n) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Gets the number of elements a vector can hold without reallocating
+ */
+size_t SCE_Vector_GetCapacity (const SCE_SVector *v)
+{
+    return v->capacity;
+}
+
+/**
+ * \brief Adds an element at the end of a vector
+ * \param elt the element, copied
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_Vector_Append (SCE_SVector *v, const void *elt)
+{
+    if (v->n == v->capacity) {
+        size_t capacity = MAX (2 * v->capacity, SCE_VECTOR_MIN_CAPACITY);
+        if (SCE_Vector_Realloc (v, capacity) < 0) {
+            SCEE_LogSrc ();
+            return SCE_ERROR;
+        }
+    }
+    memcpy (&v->data[v->n * v->elt_size], elt, v->elt_size);
+    v->n++;
+    return SCE_OK;
+}
+/**
+ * \brief Adds a pointer at the end of a vector of pointers
+ * \sa SCE_Vector_Append()
+ */
+int SCE_Vector_AppendPtr (SCE_SVector *v, void *p)
+{
+    if (SCE_Vector_Append (v, &p) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Removes an element from a vector, keeping the order of the others
+ * \param i index of the element
+ *
+ * The elements after \p i are moved, use SCE_Vector_SwapRemove() when the
+ * order doesn't matter.
+ */
+void SCE_Vector_Remove (SCE_SVector *v, size_t i)
+{
+    memmove (&v->data[i * v->elt_size], &v->data[(i + 1) * v->elt_size],
+             (v->n - i - 1) * v->elt_size);
+    v->n--;
+}
+/**
+ * \brief Removes an element from a vector in constant time
+ * \param i index of the element
+ *
+ * The last element takes the place of the removed one.
+ */
+void SCE_Vector_SwapRemove (SCE_SVector *v, size_t i)
+{
+    v->n--;
+    if (i != v->n)
+        memcpy (&v->data[i * v->elt_size], &v->data[v->n * v->elt_size],
+                v->elt_size);
+}
+/**
+ * \brief Removes the last element of a vector
+ */
+void SCE_Vector_PopBack (SCE_SVector *v)
+{
+    v->n--;
+}
+
+/**
+ * \brief Gets the address of an element of a vector
+ * \param i index of the element
+ *
+ * The address is valid until the vector grows.
+ */
+void* SCE_Vector_Get (const SCE_SVector *v, size_t i)
+{
+    return &v->data[i * v->elt_size];
+}
+/**
+ * \brief Gets a pointer stored in a vector of pointers
+ * \param i index of the pointer
+ */
+void* SCE_Vector_GetPtr (const SCE_SVector *v, size_t i)
+{
+    return ((void**)v->data)[i];
+}
+/**
+ * \brief Replaces an element of a vector
+ * \param i index of the element
+ * \param elt the new element, copied
+ */
+void SCE_Vector_Set (SCE_SVector *v, size_t i, const void *elt)
+{
+    memcpy (&v->data[i * v->elt_size], elt, v->elt_size);
+}
+/**
+ * \brief Gets the number of elements of a vector
+ */
+size_t SCE_Vector_GetLength (const SCE_SVector *v)
+{
+    return v->n;
+}
+/**
+ * \brief Searches a pointer in a vector of pointers
+ * \returns the index of the first occurrence of \p p, or -1
+ */
+long SCE_Vector_LocatePtr (const SCE_SVector *v, const void *p)
+{
+    size_t i;
+    for (i = 0; i < v->n; i++) {
+        if (((void**)v->data)[i] == p)
+            return i;
+    }
+    return -1;
+}
+
+
+/* a range of a vector run by one task of SCE_Vector_ParallelForEach() */
+typedef struct sce_svectorchunk SCE_SVectorChunk;
+struct sce_svectorchunk {
+    SCE_SThreadTask task;
+    unsigned char *first;
+    size_t n, elt_size;
+    SCE_FVectorForEach f;
+    void *arg;
+};
+
+static void SCE_Vector_RunChunk (void *arg)
+{
+    SCE_SVectorChunk *c = arg;
+    size_t i;
+    for (i = 0; i < c->n; i++)
+        c->f (&c->first[i * c->elt_size], c->arg);
+}
+
+/**
+ * \brief Calls a function on every element of a vector, from several
+ * threads
+ * \param pool thread pool running the calls, NULL for the default one
+ * \param n_chunks number of ranges \p v is split into, 0 means one per
+ * thread of \p pool plus one for the calling thread
+ * \param f function called with the address of each element and the
+ * argument of its range
+ * \param args one argument per range, or NULL
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ * \sa SCE_List_ParallelForEach()
+ */
+int SCE_Vector_ParallelForEach (SCE_SThreadPool *pool, SCE_SVector *v,
+                                unsigned int n_chunks, SCE_FVectorForEach f,
+                                void **args)
+{
+    SCE_SVectorChunk *chunks = NULL;
+    SCE_SThreadGroup group;
+    size_t start = 0;
+    unsigned int i;
+
+    if (!pool)
+        pool = SCE_ThreadPool_GetDefault ();
+    if (!n_chunks)
+        n_chunks = SCE_ThreadPool_GetNumThreads (pool) + 1;
+    if (!v->n)
+        return SCE_OK;
+    if (!(chunks = SCE_malloc (n_chunks * sizeof *chunks))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+
+    SCE_ThreadPool_InitGroup (&group);
+    for (i = 0; i < n_chunks; i++) {
+        SCE_SVectorChunk *c = &chunks[i];
+        c->n = v->n / n_chunks + (i < v->n % n_chunks);
+        c->first = &v->data[start * v->elt_size];
+        c->elt_size = v->elt_size;
+        c->f = f;
+        c->arg = args ? args[i] : NULL;
+        start += c->n;
+        SCE_ThreadPool_InitTask (&c->task, SCE_Vector_RunChunk, c);
+        if (c->n)
+            SCE_ThreadPool_Push (pool, &group, &c->task);
+    }
+    SCE_ThreadPool_Wait (pool, &group);
+
+    SCE_free (chunks);
+    return SCE_OK;
+}
+
+/** @} */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 06/05/2012
-   updated: 22/08/2012 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 #include <string.h>
@@ -331,6 +331,9 @@ void SCE_Decode_Floats (float *floats, size_t n_floats, int se,
 }
 
 
+/* number of sets of 8 floats given to the file at once */
+#define SCE_ENCODE_STREAM_CHUNKS 16
+
 size_t SCE_Encode_StreamFloat (float f, int se, unsigned char ne,
                                unsigned char nm, SCE_SFile *fp)
 {
@@ -384,13 +387,13 @@ size_t SCE_Encode_StreamFloats (const float *f, size_t n, int se,
 {
     /* stream sets of bits which are multiple of 8,
        in the limit of 8 bytes per float */
-    unsigned char buf[8 * 8];
-    size_t size, total;
-
-    size = sce_bitstobytes ((se ? 1 : 0) + ne + nm);
+    unsigned char buf[SCE_ENCODE_STREAM_CHUNKS][8 * 8];
+    SCE_SFileIOVec v[SCE_ENCODE_STREAM_CHUNKS];
+    size_t total;
+    unsigned int i;
 
 #ifdef SCE_DEBUG
-    if (size > 8) {
+    if (sce_bitstobytes ((se ? 1 : 0) + ne + nm) > 8) {
         SCEE_SendMsg ("SCE_Encode_StreamFloats(): streaming of floats more "
                       "than 64 bits wide is unsupported\n");
         return 0;
@@ -399,16 +402,19 @@ size_t SCE_Encode_StreamFloats (const float *f, size_t n, int se,
 
     total = 0;
     while (n) {
-        size_t num = MIN (n, 8);
+        /* encode a few sets and write them at once */
+        for (i = 0; i < SCE_ENCODE_STREAM_CHUNKS && n; i++) {
+            size_t num = MIN (n, 8);
 
-        memset (buf, sizeof buf, 0);
-        size = 0;
-        size += SCE_Encode_Floats (f, num, se, ne, nm, buf);
-        SCE_File_Write (buf, 1, size, fp);
-        total += size;
+            memset (buf[i], 0, sizeof buf[i]);
+            v[i].data = buf[i];
+            v[i].size = SCE_Encode_Floats (f, num, se, ne, nm, buf[i]);
+            total += v[i].size;
 
-        n -= num;
-        f = &f[num];
+            n -= num;
+            f = &f[num];
+        }
+        SCE_File_WriteV (v, i, fp);
     }
 
     return total;
@@ -418,30 +424,38 @@ void SCE_Decode_StreamFloats (float *f, size_t n, int se, unsigned char ne,
 {
     /* stream sets of bits which are multiple of 8,
        in the limit of 8 bytes per float */
-    unsigned char buf[8 * 8];
-    size_t size, n_bits;
+    unsigned char buf[SCE_ENCODE_STREAM_CHUNKS][8 * 8];
+    SCE_SFileIOVec v[SCE_ENCODE_STREAM_CHUNKS];
+    size_t n_bits, num;
+    unsigned int i, n_chunks;
 
     n_bits = (se ? 1 : 0) + ne + nm;
-    size = sce_bitstobytes (n_bits);
 
 #ifdef SCE_DEBUG
-    if (size > 8) {
-        SCEE_SendMsg ("SCE_Encode_StreamFloats(): streaming of floats more "
+    if (sce_bitstobytes (n_bits) > 8) {
+        SCEE_SendMsg ("SCE_Decode_StreamFloats(): streaming of floats more "
                       "than 64 bits wide is unsupported\n");
-        return 0;
+        return;
     }
 #endif
 
     while (n) {
-        size_t num = MIN (n, 8);
-
-        memset (buf, sizeof buf, 0);
-        size = sce_bitstobytes (num * n_bits);
-        SCE_File_Read (buf, 1, size, fp);
-        SCE_Decode_Floats (f, num, se, ne, nm, buf);
-
-        n -= num;
-        f = &f[num];
+        /* read a few sets at once */
+        for (i = 0, num = n; i < SCE_ENCODE_STREAM_CHUNKS && num; i++) {
+            memset (buf[i], 0, sizeof buf[i]);
+            v[i].data = buf[i];
+            v[i].size = sce_bitstobytes (MIN (num, 8) * n_bits);
+            num -= MIN (num, 8);
+        }
+        n_chunks = i;
+        SCE_File_ReadV (v, n_chunks, fp);
+
+        for (i = 0; i < n_chunks; i++) {
+            num = MIN (n, 8);
+            SCE_Decode_Floats (f, num, se, ne, nm, buf[i]);
+            n -= num;
+            f = &f[num];
+        }
     }
 }
 
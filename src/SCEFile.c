@@ -17,10 +17,14 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 09/08/2012
-   updated: 16/08/2012 */
+   updated: 17/10/2026 */
 
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
 #include "SCE/utils/SCEFile.h"
 
 /* standard C functions */
@@ -89,6 +93,118 @@ static size_t my_length (const void *f)
     return (size_t)size;                /* ugly cast */
 }
 
+static const void* my_map (void *f, size_t *size)
+{
+    void *p = NULL;
+    FILE *fp = f;
+
+    /* pending writes must reach the file before it is mapped */
+    if (fflush (fp)) {
+        SCEE_LogErrno ("fflush()");
+        return NULL;
+    }
+    *size = my_length (fp);
+    if (*size == 0) {
+        /* mmap() refuses empty mappings */
+        static const char empty = 0;
+        return &empty;
+    }
+    p = mmap (NULL, *size, PROT_READ, MAP_SHARED, fileno (fp), 0);
+    if (p == MAP_FAILED) {
+        SCEE_LogErrno ("mmap()");
+        return NULL;
+    }
+    return p;
+}
+static void my_unmap (void *f, const void *p, size_t size)
+{
+    (void)f;
+    if (size > 0)
+        munmap ((void*)p, size);
+}
+
+/* the stdio buffer is flushed (and its read-ahead dropped) so that pread()
+   and pwrite() see the same data as fread() and fwrite() */
+static size_t my_pread (void *ptr, size_t size, size_t nmemb, long offset,
+                        void *f)
+{
+    unsigned char *p = ptr;
+    size_t s = size * nmemb, done = 0;
+    ssize_t r;
+    FILE *fp = f;
+
+    if (!size || fflush (fp))
+        return 0;
+    while (done < s) {
+        r = pread (fileno (fp), &p[done], s - done, offset + done);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0) {
+            if (r < 0)
+                SCEE_LogErrno ("pread()");
+            break;
+        }
+        done += r;
+    }
+    return done / size;
+}
+static size_t my_pwrite (const void *ptr, size_t size, size_t nmemb,
+                         long offset, void *f)
+{
+    const unsigned char *p = ptr;
+    size_t s = size * nmemb, done = 0;
+    ssize_t r;
+    FILE *fp = f;
+
+    if (!size || fflush (fp))
+        return 0;
+    while (done < s) {
+        r = pwrite (fileno (fp), &p[done], s - done, offset + done);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r <= 0) {
+            if (r < 0)
+                SCEE_LogErrno ("pwrite()");
+            break;
+        }
+        done += r;
+    }
+    return done / size;
+}
+
+/* readv() and writev() would bypass the stdio buffer, which already merges
+   small transfers; the stream is only locked once for all the buffers */
+static size_t my_readv (const SCE_SFileIOVec *v, size_t n, void *f)
+{
+    size_t i, r, done = 0;
+    FILE *fp = f;
+
+    flockfile (fp);
+    for (i = 0; i < n; i++) {
+        r = fread (v[i].data, 1, v[i].size, fp);
+        done += r;
+        if (r < v[i].size)
+            break;
+    }
+    funlockfile (fp);
+    return done;
+}
+static size_t my_writev (const SCE_SFileIOVec *v, size_t n, void *f)
+{
+    size_t i, r, done = 0;
+    FILE *fp = f;
+
+    flockfile (fp);
+    for (i = 0; i < n; i++) {
+        r = fwrite (v[i].data, 1, v[i].size, fp);
+        done += r;
+        if (r < v[i].size)
+            break;
+    }
+    funlockfile (fp);
+    return done;
+}
+
 int SCE_Init_File (void)
 {
     sce_cfs.udata = NULL;
@@ -104,6 +220,12 @@ int SCE_Init_File (void)
     sce_cfs.xflush = (SCE_FFlushFunc)fflush;
     sce_cfs.xtruncate = my_truncate;
     sce_cfs.xlength = my_length;
+    sce_cfs.xmap = my_map;
+    sce_cfs.xunmap = my_unmap;
+    sce_cfs.xpread = my_pread;
+    sce_cfs.xpwrite = my_pwrite;
+    sce_cfs.xreadv = my_readv;
+    sce_cfs.xwritev = my_writev;
     return SCE_OK;
 }
 void SCE_Quit_File (void)
@@ -155,6 +277,109 @@ size_t SCE_File_Write (const void *ptr, size_t size, size_t nmemb,
     return fp->fs->xwrite (ptr, size, nmemb, fp->file);
 }
 
+/**
+ * \brief Reads from a file at a given offset
+ * \param offset position of the first byte to read, in bytes
+ * \returns the number of elements read, like SCE_File_Read()
+ *
+ * The current position of the file is neither used nor changed. When the
+ * file system of \p fp provides xpread, like sce_cfs, sce_mmapfs and
+ * sce_cachefs do, different threads can read the same file at the same time;
+ * on sce_mmapfs and sce_cachefs that only holds as long as nothing makes the
+ * file longer (SCE_File_WriteAt() or SCE_File_Write() past its end), which
+ * moves its memory. Otherwise the read is done with seek and read
+ * operations, which is neither faster nor thread-safe.
+ * \sa SCE_File_WriteAt()
+ */
+size_t SCE_File_ReadAt (void *ptr, size_t size, size_t nmemb, long offset,
+                        SCE_SFile *fp)
+{
+    long pos;
+    size_t n;
+
+    if (fp->fs->xpread)
+        return fp->fs->xpread (ptr, size, nmemb, offset, fp->file);
+
+    pos = SCE_File_Tell (fp);
+    if (SCE_File_Seek (fp, offset, SEEK_SET))
+        return 0;
+    n = SCE_File_Read (ptr, size, nmemb, fp);
+    SCE_File_Seek (fp, pos, SEEK_SET);
+    return n;
+}
+/**
+ * \brief Writes into a file at a given offset
+ * \param offset position of the first byte to write, in bytes
+ * \returns the number of elements written, like SCE_File_Write()
+ *
+ * The current position of the file is neither used nor changed.
+ * \sa SCE_File_ReadAt()
+ */
+size_t SCE_File_WriteAt (const void *ptr, size_t size, size_t nmemb,
+                         long offset, SCE_SFile *fp)
+{
+    long pos;
+    size_t n;
+
+    if (fp->fs->xpwrite)
+        return fp->fs->xpwrite (ptr, size, nmemb, offset, fp->file);
+
+    pos = SCE_File_Tell (fp);
+    if (SCE_File_Seek (fp, offset, SEEK_SET))
+        return 0;
+    n = SCE_File_Write (ptr, size, nmemb, fp);
+    SCE_File_Seek (fp, pos, SEEK_SET);
+    return n;
+}
+
+/**
+ * \brief Reads a file into several buffers
+ * \param v the buffers to fill, in order
+ * \param n number of buffers
+ * \returns the number of bytes read
+ *
+ * Same as calling SCE_File_Read() once for each buffer, but the file system
+ * is only called once if it provides xreadv.
+ * \sa SCE_File_WriteV()
+ */
+size_t SCE_File_ReadV (const SCE_SFileIOVec *v, size_t n, SCE_SFile *fp)
+{
+    size_t i, r, done = 0;
+
+    if (fp->fs->xreadv)
+        return fp->fs->xreadv (v, n, fp->file);
+
+    for (i = 0; i < n; i++) {
+        r = SCE_File_Read (v[i].data, 1, v[i].size, fp);
+        done += r;
+        if (r < v[i].size)
+            break;
+    }
+    return done;
+}
+/**
+ * \brief Writes several buffers into a file
+ * \param v the buffers to write, in order
+ * \param n number of buffers
+ * \returns the number of bytes written
+ * \sa SCE_File_ReadV()
+ */
+size_t SCE_File_WriteV (const SCE_SFileIOVec *v, size_t n, SCE_SFile *fp)
+{
+    size_t i, r, done = 0;
+
+    if (fp->fs->xwritev)
+        return fp->fs->xwritev (v, n, fp->file);
+
+    for (i = 0; i < n; i++) {
+        r = SCE_File_Write (v[i].data, 1, v[i].size, fp);
+        done += r;
+        if (r < v[i].size)
+            break;
+    }
+    return done;
+}
+
 int SCE_File_Seek (SCE_SFile *fp, long offset, int whence)
 {
     return fp->fs->xseek (fp->file, offset, whence);
@@ -182,3 +407,62 @@ size_t SCE_File_Length (const SCE_SFile *fp)
 {
     return fp->fs->xlength (fp->file);
 }
+
+/**
+ * \brief Gives a read-only pointer to the whole content of a file
+ * \param size where to store the length of the file, in bytes
+ * \returns a pointer to the content of the file or NULL on error
+ *
+ * File systems that can do it (see sce_mmapfs) give a pointer to their own
+ * memory, no copy is done. The other ones get the file read into a buffer;
+ * the current position of the file is kept in both cases. The pointer must
+ * be given back with SCE_File_Unmap() and becomes invalid if the file is
+ * written to, truncated or closed.
+ * \sa SCE_File_Unmap()
+ */
+const void* SCE_File_Map (SCE_SFile *fp, size_t *size)
+{
+    const void *p = NULL;
+    void *data = NULL;
+    long pos;
+    size_t length;
+
+    if (fp->fs->xmap) {
+        if (!(p = fp->fs->xmap (fp->file, size)))
+            SCEE_LogSrc ();
+        return p;
+    }
+
+    length = SCE_File_Length (fp);
+    /* allocate at least one byte so that empty files are not an error */
+    if (!(data = SCE_malloc (length ? length : 1)))
+        goto fail;
+    pos = SCE_File_Tell (fp);
+    SCE_File_Rewind (fp);
+    if (SCE_File_Read (data, 1, length, fp) != length) {
+        SCE_free (data);
+        SCE_File_Seek (fp, pos, SEEK_SET);
+        SCEE_Log (42);
+        SCEE_LogMsg ("can't read the whole file");
+        goto fail;
+    }
+    SCE_File_Seek (fp, pos, SEEK_SET);
+    *size = length;
+    return data;
+fail:
+    SCEE_LogSrc ();
+    return NULL;
+}
+/**
+ * \brief Releases a pointer given by SCE_File_Map()
+ * \param p the pointer
+ * \param size the size given by SCE_File_Map()
+ */
+void SCE_File_Unmap (SCE_SFile *fp, const void *p, size_t size)
+{
+    if (fp->fs->xmap) {
+        if (fp->fs->xunmap)
+            fp->fs->xunmap (fp->file, p, size);
+    } else
+        SCE_free ((void*)p);
+}
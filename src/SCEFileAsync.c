@@ -0,0 +1,234 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <pthread.h>
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEFileAsync.h"
+
+/**
+ * \file SCEFileAsync.c
+ * \copydoc fileasync
+ * \brief Asynchronous file transfers
+ *
+ * \file SCEFileAsync.h
+ * \copydoc fileasync
+ * \brief Asynchronous file transfers
+ */
+
+/**
+ * \defgroup fileasync Asynchronous file transfers
+ * \ingroup utils
+ *
+ * Requests are serviced by a thread pool of their own, whose threads
+ * spend their time waiting for the disk rather than computing, with
+ * SCE_File_ReadAt() and SCE_File_WriteAt(); they work with any file
+ * system. Write requests are run one at a time since a write can make a
+ * file longer, which moves the memory of sce_mmapfs and sce_cachefs files
+ * under the feet of concurrent readers. Read requests on the same file
+ * run concurrently if its file system provides xpread (sce_cfs,
+ * sce_mmapfs and sce_cachefs do), otherwise every request on that file
+ * must be issued one after the other.
+ */
+
+/** @{ */
+
+static SCE_SThreadPool io_pool;
+static int io_started = SCE_FALSE;
+static pthread_mutex_t io_mutex = PTHREAD_MUTEX_INITIALIZER;
+/* shared by reads, exclusive for writes */
+static pthread_rwlock_t io_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+/**
+ * \internal
+ * \brief Initializes the I/O thread pool, its threads are only started by
+ * the first request
+ */
+int SCE_Init_FileAsync (void)
+{
+    SCE_ThreadPool_Init (&io_pool);
+    io_started = SCE_FALSE;
+    return SCE_OK;
+}
+/**
+ * \internal
+ * \brief Completes the pending requests and stops the I/O threads
+ */
+void SCE_Quit_FileAsync (void)
+{
+    SCE_ThreadPool_Clear (&io_pool);
+    io_started = SCE_FALSE;
+}
+
+static SCE_SThreadPool* SCE_File_GetIOPool (void)
+{
+    pthread_mutex_lock (&io_mutex);
+    if (!io_started) {
+        io_started = SCE_TRUE;
+        if (SCE_ThreadPool_Start (&io_pool, SCE_FILE_ASYNC_THREADS) < 0) {
+            /* requests complete in SCE_File_WaitRequest() at worst */
+            SCEE_Clear ();
+        }
+    }
+    pthread_mutex_unlock (&io_mutex);
+    return &io_pool;
+}
+
+
+/**
+ * \brief Initializes a request
+ */
+void SCE_File_InitRequest (SCE_SFileRequest *req)
+{
+    req->fp = NULL;
+    req->data = NULL;
+    req->size = 0;
+    req->offset = 0;
+    req->write = SCE_FALSE;
+    req->done = 0;
+    req->callback = NULL;
+    req->udata = NULL;
+    SCE_ThreadPool_InitTask (&req->task, NULL, req);
+    SCE_ThreadPool_InitGroup (&req->group);
+}
+/**
+ * \brief Sets a function to call when a request completes
+ * \param f the function, NULL for none
+ * \param udata second argument of \p f
+ *
+ * \p f is called from an I/O thread, it may use SCE_File_GetRequestResult()
+ * but must neither wait for nor free the request.
+ */
+void SCE_File_SetRequestCallback (SCE_SFileRequest *req,
+                                  SCE_FFileRequestCallback f, void *udata)
+{
+    req->callback = f;
+    req->udata = udata;
+}
+
+static void SCE_File_RunRequest (void *arg)
+{
+    SCE_SFileRequest *req = arg;
+    if (req->write) {
+        pthread_rwlock_wrlock (&io_lock);
+        req->done = SCE_File_WriteAt (req->data, 1, req->size, req->offset,
+                                      req->fp);
+    } else {
+        pthread_rwlock_rdlock (&io_lock);
+        req->done = SCE_File_ReadAt (req->data, 1, req->size, req->offset,
+                                     req->fp);
+    }
+    pthread_rwlock_unlock (&io_lock);
+    if (req->callback)
+        req->callback (req, req->udata);
+}
+
+static int SCE_File_PushRequest (SCE_SFileRequest *req)
+{
+    if (!SCE_File_PollRequest (req)) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("the request is still pending");
+        return SCE_ERROR;
+    }
+    req->done = 0;
+    SCE_ThreadPool_InitTask (&req->task, SCE_File_RunRequest, req);
+    SCE_ThreadPool_Push (SCE_File_GetIOPool (), &req->group, &req->task);
+    return SCE_OK;
+}
+
+/**
+ * \brief Reads from a file in the background
+ * \param req a request that is not pending
+ * \param data where to read, must stay valid until the request completes
+ * \param size number of bytes to read
+ * \param offset position of the first byte to read
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * The current position of \p fp is not used. The request must be waited
+ * for with SCE_File_WaitRequest() or polled until it completes.
+ * \sa SCE_File_WriteAsync(), SCE_File_ReadAt()
+ */
+int SCE_File_ReadAsync (SCE_SFileRequest *req, SCE_SFile *fp, void *data,
+                        size_t size, long offset)
+{
+    req->fp = fp;
+    req->data = data;
+    req->size = size;
+    req->offset = offset;
+    req->write = SCE_FALSE;
+    if (SCE_File_PushRequest (req) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+/**
+ * \brief Writes into a file in the background
+ * \param data what to write, must stay valid until the request completes
+ * \sa SCE_File_ReadAsync(), SCE_File_WriteAt()
+ */
+int SCE_File_WriteAsync (SCE_SFileRequest *req, SCE_SFile *fp,
+                         const void *data, size_t size, long offset)
+{
+    req->fp = fp;
+    req->data = (void*)data;
+    req->size = size;
+    req->offset = offset;
+    req->write = SCE_TRUE;
+    if (SCE_File_PushRequest (req) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Checks whether a request has completed, without blocking
+ * \returns SCE_TRUE when the request is done and can be reused or freed
+ */
+int SCE_File_PollRequest (SCE_SFileRequest *req)
+{
+    int done;
+    pthread_mutex_lock (&io_pool.mutex);
+    done = !req->group.pending;
+    pthread_mutex_unlock (&io_pool.mutex);
+    return done;
+}
+/**
+ * \brief Waits until a request completes
+ * \returns the number of bytes transferred
+ *
+ * The calling thread services pending requests while it waits.
+ */
+size_t SCE_File_WaitRequest (SCE_SFileRequest *req)
+{
+    SCE_ThreadPool_Wait (&io_pool, &req->group);
+    return req->done;
+}
+/**
+ * \brief Gets the number of bytes transferred by a completed request, less
+ * than requested on error or at the end of the file
+ */
+size_t SCE_File_GetRequestResult (const SCE_SFileRequest *req)
+{
+    return req->done;
+}
+
+/** @} */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 15/08/2012
-   updated: 21/08/2012 */
+   updated: 17/10/2026 */
 
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEMemory.h"
@@ -25,6 +25,7 @@
 #include "SCE/utils/SCEString.h"
 #include "SCE/utils/SCEArray.h"
 #include "SCE/utils/SCEList.h"
+#include "SCE/utils/SCEPool.h"
 #include "SCE/utils/SCEFile.h"
 #include "SCE/utils/SCEFileCache.h"
 
@@ -45,6 +46,9 @@ struct xfile {
     SCE_SListIterator it;
 };
 
+/* files may be opened from any thread */
+static SCE_SPool xfiles_pool;
+
 static void xfile_init (xfile *file)
 {
     file->fname = NULL;
@@ -70,13 +74,13 @@ static void xfile_clear (xfile *file)
 static xfile* xfile_create (const char *fname)
 {
     xfile *file = NULL;
-    if (!(file = SCE_malloc (sizeof *file)))
+    if (!(file = SCE_Pool_New (&xfiles_pool, xfile)))
         SCEE_LogSrc ();
     else {
         xfile_init (file);
         if (!(file->fname = SCE_String_Dup (fname))) {
             SCEE_LogSrc ();
-            SCE_free (file);
+            SCE_Pool_Free (&xfiles_pool, file);
             return NULL;
         }
     }
@@ -86,7 +90,7 @@ static void xfile_delete (xfile *file)
 {
     if (file) {
         xfile_clear (file);
-        SCE_free (file);
+        SCE_Pool_Free (&xfiles_pool, file);
     }
 }
 
@@ -97,21 +101,21 @@ static int xload (xfile *file, SCE_SFile *f)
     void *data = NULL;
 
     size = SCE_File_Length (f);
-    if (!(data = SCE_malloc (size)))
+    /* read straight into the cache, no intermediate buffer */
+    if (!(data = SCE_Array_AppendUninit (&file->data, size)))
         goto fail;
     SCE_File_Rewind (f);
-    if (SCE_File_Read (data, 1, size, f) != size)
-        goto fail;
-    if (SCE_Array_Append (&file->data, data, size) < 0)
+    if (SCE_File_Read (data, 1, size, f) != size) {
+        SCE_Array_PopBack (&file->data, size);
         goto fail;
-    SCE_free (data);
+    }
 
     file->size = SCE_Array_GetSize (&file->data);
-    file->cached = SCE_TRUE;
+    /* publishes data and size to xreload_locked() */
+    __atomic_store_n (&file->cached, SCE_TRUE, __ATOMIC_RELEASE);
 
     return SCE_OK;
 fail:
-    SCE_free (data);
     SCEE_LogSrc ();
     return SCE_ERROR;
 }
@@ -304,6 +308,133 @@ static size_t xwrite (const void *data, size_t size, size_t nmemb, void *fd)
     return size * nmemb;
 }
 
+/* positional transfers can be done by several threads at once, only one of
+   them must reload an evicted file; the lock of the cache can't be used
+   since xreload() takes it. The lock is only taken when the file is not
+   cached, which is rare */
+static pthread_mutex_t reload_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int xreload_locked (xfile *file)
+{
+    int r = SCE_OK;
+    if (__atomic_load_n (&file->cached, __ATOMIC_ACQUIRE))
+        return SCE_OK;
+    pthread_mutex_lock (&reload_mutex);
+    if (!__atomic_load_n (&file->cached, __ATOMIC_ACQUIRE))
+        r = xreload (file);
+    pthread_mutex_unlock (&reload_mutex);
+    return r;
+}
+
+static size_t xpread (void *data, size_t size, size_t nmemb, long offset,
+                      void *fd)
+{
+    size_t s;
+    unsigned char *ptr = NULL;
+    xfile *file = fd;
+
+    if (!file->readable || !size || offset < 0)
+        return 0;
+    if (xreload_locked (file) < 0)
+        return 0;
+    if ((size_t)offset >= file->size)
+        return 0;
+
+    s = MIN (size * nmemb, file->size - offset);
+    ptr = SCE_Array_Get (&file->data);
+    memcpy (data, &ptr[offset], s);
+
+    return s / size;
+}
+
+static size_t xpwrite (const void *data, size_t size, size_t nmemb,
+                       long offset, void *fd)
+{
+    size_t s, end;
+    unsigned char *ptr = NULL;
+    xfile *file = fd;
+
+    if (!file->writable || offset < 0)
+        return 0;
+    if (xreload_locked (file) < 0)
+        return 0;
+
+    s = size * nmemb;
+    end = offset + s;
+    /* writing past the end leaves a zero-filled gap, like pwrite() */
+    if (end > file->size) {
+        if (SCE_Array_Append (&file->data, NULL, end - file->size) < 0) {
+            SCEE_LogSrc ();
+            return 0;
+        }
+        file->size = SCE_Array_GetSize (&file->data);
+    }
+    ptr = SCE_Array_Get (&file->data);
+    memcpy (&ptr[offset], data, s);
+    file->is_sync = SCE_FALSE;
+
+    return nmemb;
+}
+
+static size_t xreadv (const SCE_SFileIOVec *v, size_t n, void *fd)
+{
+    size_t i, s, done = 0;
+    unsigned char *ptr = NULL;
+    xfile *file = fd;
+
+    if (!file->readable)
+        return 0;
+    if (!file->cached) {
+        if (xreload (file) < 0)
+            return 0;
+    }
+
+    ptr = SCE_Array_Get (&file->data);
+    for (i = 0; i < n && file->pos < file->size; i++) {
+        s = MIN (v[i].size, file->size - file->pos);
+        memcpy (v[i].data, &ptr[file->pos], s);
+        file->pos += s;
+        done += s;
+    }
+
+    return done;
+}
+
+static size_t xwritev (const SCE_SFileIOVec *v, size_t n, void *fd)
+{
+    size_t i, total = 0;
+    unsigned char *ptr = NULL;
+    xfile *file = fd;
+
+    if (!file->writable)
+        return 0;
+    if (!file->cached) {
+        if (xreload (file) < 0)
+            return 0;
+    }
+
+    for (i = 0; i < n; i++)
+        total += v[i].size;
+    /* grow once for all the buffers */
+    if (total > file->size - file->pos) {
+        if (SCE_Array_Append (&file->data, NULL,
+                              total - (file->size - file->pos)) < 0) {
+            SCEE_LogSrc ();
+            return 0;
+        }
+        file->size = SCE_Array_GetSize (&file->data);
+    }
+
+    ptr = SCE_Array_Get (&file->data);
+    for (i = 0; i < n; i++) {
+        memcpy (&ptr[file->pos], v[i].data, v[i].size);
+        file->pos += v[i].size;
+    }
+    file->is_sync = SCE_FALSE;
+
+    return total;
+}
+
 static int xseek (void *fd, long offset, int whence)
 {
     size_t size;
@@ -376,8 +507,37 @@ static size_t xlength (const void *f)
     return file->size;
 }
 
+/* the data of a cached file are already in memory, give them directly */
+static const void* xmap (void *fd, size_t *size)
+{
+    static const char empty = 0;
+    xfile *file = fd;
+    const void *p = NULL;
+
+    if (!file->readable) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("%s was not opened for reading", file->fname);
+        return NULL;
+    }
+    if (!file->cached) {
+        if (xreload (file) < 0) {
+            SCEE_LogSrc ();
+            return NULL;
+        }
+    }
+    *size = file->size;
+    if (!(p = SCE_Array_Get (&file->data)))
+        p = &empty;
+    return p;
+}
+
 int SCE_Init_FileCache (void)
 {
+    SCE_Pool_InitTyped (&xfiles_pool, xfile);
+    if (SCE_Pool_SetThreadSafe (&xfiles_pool, SCE_TRUE) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
     sce_cachefs.udata = NULL;
     sce_cachefs.subfs = NULL;
     sce_cachefs.xinit = xinit;
@@ -391,10 +551,25 @@ int SCE_Init_FileCache (void)
     sce_cachefs.xflush = xflush;
     sce_cachefs.xtruncate = xtruncate;
     sce_cachefs.xlength = xlength;
+    sce_cachefs.xmap = xmap;
+    sce_cachefs.xunmap = NULL;
+    sce_cachefs.xpread = xpread;
+    sce_cachefs.xpwrite = xpwrite;
+    sce_cachefs.xreadv = xreadv;
+    sce_cachefs.xwritev = xwritev;
     return SCE_OK;
 }
 void SCE_Quit_FileCache (void)
 {
+    size_t n = SCE_Pool_GetNumUsed (&xfiles_pool);
+    /* open files still point into the pool, leak it rather than leaving
+       them dangling */
+    if (n) {
+        SCEE_SendMsg ("SCE_Quit_FileCache(): %lu cached files are still "
+                      "open, their memory is not freed\n", (unsigned long)n);
+        return;
+    }
+    SCE_Pool_Clear (&xfiles_pool);
 }
 
 
@@ -454,7 +629,7 @@ static void SCE_FileCache_Uncache (SCE_SFileCache *fc, xfile *file)
     xflush (file);              /* TODO: what if xflush() fails? */
     SCE_Array_Clear (&file->data);
     SCE_Array_Init (&file->data);
-    file->cached = SCE_FALSE;
+    __atomic_store_n (&file->cached, SCE_FALSE, __ATOMIC_RELEASE);
 }
 
 
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 21/09/2007
-   updated: 14/03/2012 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 
@@ -94,6 +94,8 @@ void SCE_List_Init (SCE_SList *l)
     l->f2arg = NULL;
     /* TODO: kick useless calls of CanDeleteIterators() in the engine */
     l->canfree = SCE_FALSE;     /* by default, CANT free iterators */
+    l->length = 0;
+    l->counted = SCE_FALSE;
 }
 /**
  * \brief Creates a new list
@@ -150,6 +152,7 @@ void SCE_List_Flush (SCE_SList *l)
         l->last.prev->next = NULL;
         SCE_List_JoinFirstLast (l);
     }
+    l->length = 0;
 }
 /**
  * \brief Clears a list
@@ -168,6 +171,7 @@ void SCE_List_Clear (SCE_SList *l)
     SCE_SListIterator *it = NULL;
     SCE_List_ForEachProtected (pro, it, l)
         SCE_List_Erase (l, it);
+    l->length = 0;
 }
 /**
  * \brief Deletes a list
@@ -224,6 +228,57 @@ void SCE_List_SetFreeFunc2 (SCE_SList *l, SCE_FListFreeFunc2 f, void *a)
     l->f2arg = a;
 }
 
+/* counts the elements of \p l only, not of the lists joined to it */
+static unsigned int SCE_List_CountOwn (const SCE_SList *l)
+{
+    const SCE_SListIterator *it = NULL;
+    unsigned int n = 1;
+    /* an empty list joined to another one has its last.prev pointing into
+       the previous list, only trust first.next */
+    if (!SCE_List_HasElements (l) || l->last.prev == &l->first)
+        return 0;
+    for (it = l->first.next; it != l->last.prev; it = it->next)
+        n++;
+    return n;
+}
+
+/**
+ * \brief Makes a list keep track of its number of elements
+ * \param l A list
+ * \param counted can be SCE_TRUE or SCE_FALSE
+ *
+ * SCE_List_GetLength() is O(1) on a counted list. The counter is kept by
+ * the functions taking the list, like SCE_List_Appendl() or
+ * SCE_List_Erase(); the iterator only functions like SCE_List_Append() or
+ * SCE_List_Removel() can't update it, use SCE_List_Appendc(),
+ * SCE_List_Prependc() and SCE_List_Removec() instead.
+ * \sa SCE_List_CheckCounter()
+ */
+void SCE_List_SetCounted (SCE_SList *l, int counted)
+{
+    if (counted)
+        l->length = SCE_List_CountOwn (l);
+    l->counted = counted;
+}
+/**
+ * \brief Checks the counter of a counted list against its elements
+ * \returns SCE_ERROR if the counter is wrong, SCE_OK otherwise
+ * \sa SCE_List_SetCounted()
+ */
+int SCE_List_CheckCounter (const SCE_SList *l)
+{
+    unsigned int n;
+    if (!l->counted)
+        return SCE_OK;
+    if ((n = SCE_List_CountOwn (l)) != l->length) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("counted list has %u elements but a counter of %u, an "
+                     "iterator function was probably used", n, l->length);
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
 /**
  * \brief Check whether an iterator it attached to a list
  * \param it an iterator
@@ -281,6 +336,7 @@ void SCE_List_Prependl (SCE_SList *l, SCE_SListIterator *it)
     it->next = l->first.next;
     l->first.next->prev = it;
     l->first.next = it;
+    l->length++;
 }
 /**
  * \brief
@@ -291,9 +347,33 @@ void SCE_List_Appendl (SCE_SList *l, SCE_SListIterator *it)
     it->prev = l->last.prev;
     l->last.prev->next = it;
     l->last.prev = it;
+    l->length++;
 }
 #endif
 
+/**
+ * \brief Prepends \p new to \p it, keeping the counter of \p l
+ * \param l the list of \p it
+ * \sa SCE_List_Prepend(), SCE_List_SetCounted()
+ */
+void SCE_List_Prependc (SCE_SList *l, SCE_SListIterator *it,
+                        SCE_SListIterator *new)
+{
+    SCE_List_Prepend (it, new);
+    l->length++;
+}
+/**
+ * \brief Appends \p new to \p it, keeping the counter of \p l
+ * \param l the list of \p it
+ * \sa SCE_List_Append(), SCE_List_SetCounted()
+ */
+void SCE_List_Appendc (SCE_SList *l, SCE_SListIterator *it,
+                       SCE_SListIterator *new)
+{
+    SCE_List_Append (it, new);
+    l->length++;
+}
+
 /**
  * \brief Prepends data to a list iterator
  * \param i the SCE_SListIterator where data has to be prepended
@@ -380,9 +460,11 @@ int SCE_List_AppendNewl (SCE_SList *l, void *d)
 void SCE_List_PrependAll (SCE_SList *l1, SCE_SList *l2)
 {
     if (SCE_List_HasElements (l2)) {
+        l1->length += l2->counted ? l2->length : SCE_List_CountOwn (l2);
         SCE_List_Attach (l2->last.prev, l1->first.next);
         SCE_List_Attach (&l1->first, l2->first.next);
         SCE_List_JoinFirstLast (l2); /* flush */
+        l2->length = 0;
     }
 }
 /**
@@ -392,9 +474,11 @@ void SCE_List_PrependAll (SCE_SList *l1, SCE_SList *l2)
 void SCE_List_AppendAll (SCE_SList *l1, SCE_SList *l2)
 {
     if (SCE_List_HasElements (l2)) {
+        l1->length += l2->counted ? l2->length : SCE_List_CountOwn (l2);
         SCE_List_Attach (l1->last.prev, l2->first.next);
         SCE_List_Attach (l2->last.prev, &l1->last);
         SCE_List_JoinFirstLast (l2); /* flush */
+        l2->length = 0;
     }
 }
 
@@ -438,6 +522,17 @@ void SCE_List_Removel (SCE_SListIterator *it)
     it->prev = NULL;
 }
 #endif
+/**
+ * \brief Removes an element of a list, keeping the counter of \p l
+ * \param l the list of \p it
+ * \param it the iterator to detach
+ * \sa SCE_List_Removel(), SCE_List_SetCounted()
+ */
+void SCE_List_Removec (SCE_SList *l, SCE_SListIterator *it)
+{
+    SCE_List_Removel (it);
+    l->length--;
+}
 /**
  * \brief Removes the first element of a list
  * \param l the SCE_SList from where detach data
@@ -449,7 +544,7 @@ void SCE_List_Removel (SCE_SListIterator *it)
 SCE_SListIterator* SCE_List_RemoveFirst (SCE_SList *l)
 {
     SCE_SListIterator *it = l->first.next;
-    SCE_List_Removel (it);
+    SCE_List_Removec (l, it);
     return it;
 }
 /**
@@ -463,7 +558,7 @@ SCE_SListIterator* SCE_List_RemoveFirst (SCE_SList *l)
 SCE_SListIterator* SCE_List_RemoveLast (SCE_SList *l)
 {
     SCE_SListIterator *it = l->last.prev;
-    SCE_List_Removel (it);
+    SCE_List_Removec (l, it);
     return it;
 }
 
@@ -475,6 +570,8 @@ SCE_SListIterator* SCE_List_RemoveLast (SCE_SList *l)
  */
 void SCE_List_Erase (SCE_SList *l, SCE_SListIterator *it)
 {
+    if (SCE_List_IsAttached (it))
+        l->length--;
     SCE_List_Remove (it);
     if (l->f)
         l->f (it->data);
@@ -540,7 +637,7 @@ void SCE_List_RemoveFromData (SCE_SList *l, void *data)
 {
     SCE_SListIterator *it = SCE_List_LocateIterator (l, data, NULL);
     if (it)
-        SCE_List_Removel (it);
+        SCE_List_Removec (l, it);
 }
 
 /**
@@ -704,11 +801,28 @@ void* SCE_List_GetData (SCE_SListIterator *it)
  * \brief Gets the length of a SCE_SList
  * \param l a SCE_SList
  * \returns the length of the list pointed by \p l
+ *
+ * Like SCE_List_ForEach(), the elements of the lists joined after \p l are
+ * counted. This is O(1) per list when they are all counted.
+ * \sa SCE_List_SetCounted()
  */
 unsigned int SCE_List_GetLength (const SCE_SList *l)
 {
     unsigned int n = 0;
+    const SCE_SList *list = l;
     SCE_SListIterator *it;
+
+    for (; list && list->counted;
+         list = list->last.next ? list->last.next->data : NULL) {
+#ifdef SCE_DEBUG
+        SCE_List_CheckCounter (list);
+#endif
+        n += list->length;
+    }
+    if (!list)
+        return n;
+
+    n = 0;
     SCE_List_ForEach (it, l)
         n++;
     return n;
@@ -899,6 +1013,8 @@ static unsigned int SCE_List_QuickSortPartition (SCE_SList *l,
 
 /**
  * \brief Sorts a specified range in a list
+ * \deprecated locating the partitions walks the list, which makes this
+ * function O(n^2) at best, use SCE_List_MergeSort()
  * \param l a list
  * \param start the start of the range
  * \param end the end of the range, plus one (e.g. SCE_List_GetLength())
@@ -1014,7 +1130,9 @@ void SCE_List_Swap (SCE_SListIterator *a, SCE_SListIterator *b)
  * @param l a list
  * @param func a function used to compare two elements of the list
  * 
- * This function sorts a list using the GnomeSort algorithm.
+ * This function sorts a list using the GnomeSort algorithm, which is
+ * O(n^2) but fast on lists that are almost sorted.
+ * \sa SCE_List_MergeSort()
  */
 void SCE_List_GnomeSort (SCE_SList *l, SCE_FListCompareData func)
 {
@@ -1043,4 +1161,83 @@ void SCE_List_GnomeSort (SCE_SList *l, SCE_FListCompareData func)
     }
 }
 
+/**
+ * \brief Sorts a list
+ * \param l a list
+ * \param func a function used to compare two elements of the list, the
+ * elements are swapped when it returns a positive value
+ *
+ * Stable bottom-up merge sort of the iterators of \p l, in O(n log n) and
+ * without any allocation. Only the elements of \p l are sorted, the lists
+ * joined to it are left untouched.
+ * \sa SCE_List_Sort()
+ */
+void SCE_List_MergeSort (SCE_SList *l, SCE_FListCompareData func)
+{
+    SCE_SListIterator *before = NULL, *after = NULL;
+    SCE_SListIterator *list = NULL, *tail = NULL, *p = NULL, *q = NULL;
+    SCE_SListIterator *e = NULL;
+    unsigned int insize, nmerges, psize, qsize, i;
+
+    /* an empty list joined to another one has its last.prev pointing into
+       the previous list, only first.next can be trusted */
+    if (!SCE_List_HasElements (l) || l->first.next == l->last.prev)
+        return;                 /* less than two elements */
+
+    /* cut the elements of l as a NULL terminated chain; the neighbours are
+       &l->first and &l->last unless l is joined to other lists */
+    before = l->first.next->prev;
+    after = l->last.prev->next;
+    list = l->first.next;
+    l->last.prev->next = NULL;
+
+    /* merge runs of insize elements, doubling insize at each pass; the prev
+       pointers are only restored at the end */
+    for (insize = 1;; insize *= 2) {
+        p = list;
+        list = tail = NULL;
+        nmerges = 0;
+
+        while (p) {
+            nmerges++;
+            q = p;
+            psize = 0;
+            for (i = 0; i < insize && q; i++) {
+                psize++;
+                q = q->next;
+            }
+            qsize = insize;
+
+            while (psize > 0 || (qsize > 0 && q)) {
+                /* take from p on equality, to be stable */
+                if (!psize) {
+                    e = q; q = q->next; qsize--;
+                } else if (!qsize || !q || func (p->data, q->data) <= 0) {
+                    e = p; p = p->next; psize--;
+                } else {
+                    e = q; q = q->next; qsize--;
+                }
+                if (tail)
+                    tail->next = e;
+                else
+                    list = e;
+                tail = e;
+            }
+            p = q;
+        }
+        tail->next = NULL;
+        if (nmerges <= 1)
+            break;
+    }
+
+    /* restore the prev pointers and reconnect the chain */
+    before->next = list;
+    l->first.next = list;
+    for (p = before; p->next; p = p->next)
+        p->next->prev = p;
+    p->next = after;
+    after->prev = p;
+    l->last.prev = p;
+}
+
 /** @} */
@@ -17,11 +17,14 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 26/01/2009
-   updated: 10/04/2010 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 
 #include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEMath.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
 #include "SCE/utils/SCEListFastForeach.h"
 
 #define SCE_NUM_SIZES 9
@@ -275,3 +278,118 @@ void SCE_List_FastForEach4 (SCE_SList *l, unsigned int size,
             it = fastfuncs4[i] (it, f);
     }
 }
+
+
+/**
+ * \brief Calls a function on the elements of a list, several at once
+ * \param l the list
+ * \param batch maximum number of elements given to each call of \p f, 0
+ * means SCE_LIST_BATCH_SIZE, at most SCE_LIST_MAX_BATCH_SIZE
+ * \param f function called with an array of the data of up to \p batch
+ * consecutive elements, its size, and \p arg
+ * \param arg user argument for \p f
+ *
+ * The iterators of a batch are gathered ahead of the call and their data
+ * prefetched, so the cache misses on the data of a whole batch overlap
+ * instead of stalling one element at a time. Since only
+ * the data pointers are handed over, \p f may remove the elements of its
+ * batch from \p l, like SCE_List_ForEachProtected() would allow.
+ * \sa SCE_List_FastForEach2()
+ */
+void SCE_List_BatchForEach (SCE_SList *l, unsigned int batch,
+                            SCE_FListBatchForeach f, void *arg)
+{
+    void *data[SCE_LIST_MAX_BATCH_SIZE];
+    SCE_SListIterator *it = l->first.next;
+    unsigned int n;
+
+    if (!batch)
+        batch = SCE_LIST_BATCH_SIZE;
+    batch = MIN (batch, SCE_LIST_MAX_BATCH_SIZE);
+
+    while (it->next) {
+        for (n = 0; n < batch && it->next; n++) {
+            SCE_GNUC_PREFETCH (it->data);
+            data[n] = it->data;
+            it = it->next;
+        }
+        f (data, n, arg);
+    }
+}
+
+/* a range of a list run by one task of SCE_List_ParallelForEach() */
+typedef struct sce_slistchunk SCE_SListChunk;
+struct sce_slistchunk {
+    SCE_SThreadTask task;
+    SCE_SListIterator *first;
+    unsigned int n;
+    SCE_FListFastForeach2 f;
+    void *arg;
+};
+
+static void SCE_List_RunChunk (void *arg)
+{
+    SCE_SListChunk *c = arg;
+    SCE_SListIterator *it = c->first;
+    unsigned int i;
+    for (i = 0; i < c->n; i++) {
+        c->f (it->data, c->arg);
+        it = it->next;
+    }
+}
+
+/**
+ * \brief Calls a function on every element of a list, from several threads
+ * \param pool thread pool running the calls, NULL for the default one
+ * \param l the list
+ * \param n_chunks number of ranges \p l is split into, 0 means one per
+ * thread of \p pool plus one for the calling thread
+ * \param f function called with the data of each element and the argument
+ * of its range
+ * \param args one argument per range, or NULL
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * Returns once \p f was called on every element. \p f must not modify
+ * \p l and the calls are done in no particular order.
+ * \sa SCE_List_FastForEach2(), SCE_ThreadPool_GetDefault()
+ */
+int SCE_List_ParallelForEach (SCE_SThreadPool *pool, SCE_SList *l,
+                              unsigned int n_chunks, SCE_FListFastForeach2 f,
+                              void **args)
+{
+    SCE_SListChunk *chunks = NULL;
+    SCE_SThreadGroup group;
+    SCE_SListIterator *it = NULL;
+    unsigned int i, j, n;
+
+    if (!pool)
+        pool = SCE_ThreadPool_GetDefault ();
+    if (!n_chunks)
+        n_chunks = SCE_ThreadPool_GetNumThreads (pool) + 1;
+    if (!(n = SCE_List_GetLength (l)))
+        return SCE_OK;
+    if (!(chunks = SCE_malloc (n_chunks * sizeof *chunks))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+
+    SCE_ThreadPool_InitGroup (&group);
+    it = SCE_List_GetFirst (l);
+    for (i = 0; i < n_chunks; i++) {
+        SCE_SListChunk *c = &chunks[i];
+        /* spread the remainder over the first chunks */
+        c->n = n / n_chunks + (i < n % n_chunks);
+        c->first = it;
+        c->f = f;
+        c->arg = args ? args[i] : NULL;
+        for (j = 0; j < c->n; j++)
+            it = it->next;
+        SCE_ThreadPool_InitTask (&c->task, SCE_List_RunChunk, c);
+        if (c->n)
+            SCE_ThreadPool_Push (pool, &group, &c->task);
+    }
+    SCE_ThreadPool_Wait (pool, &group);
+
+    SCE_free (chunks);
+    return SCE_OK;
+}
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 05/01/2007
-   updated: 25/06/2011 */
+   updated: 17/10/2026 */
 
 #include <stdio.h>
 #include <errno.h>
@@ -26,6 +26,7 @@
 #include "SCE/utils/SCEMemory.h"
 #include "SCE/utils/SCEString.h"
 #include "SCE/utils/SCEList.h"
+#include "SCE/utils/SCEPool.h"
 #include "SCE/utils/SCEMedia.h"
 
 
@@ -60,6 +61,7 @@ struct sce_smediatype {
 };
 
 static SCE_SList funs;
+static SCE_SPool types_pool;
 
 static SCE_FMediaParsePathFunc parse_fun = NULL;
 static void *parse_data = NULL;
@@ -77,7 +79,7 @@ static void SCE_Media_InitType (SCE_SMediaType *type)
 static SCE_SMediaType* SCE_Media_CreateType (void)
 {
     SCE_SMediaType *type = NULL;
-    if (!(type = SCE_malloc (sizeof *type))) {
+    if (!(type = SCE_Pool_New (&types_pool, SCE_SMediaType))) {
         SCEE_LogSrc ();
         return NULL;
     }
@@ -89,7 +91,7 @@ static void SCE_Media_DeleteType (void *t)
     if (t) {
         SCE_SMediaType *type = t;
         SCE_free (type->exts);
-        SCE_free (type);
+        SCE_Pool_Free (&types_pool, type);
     }
 }
 
@@ -99,6 +101,7 @@ static void SCE_Media_DeleteType (void *t)
  */
 int SCE_Init_Media (void)
 {
+    SCE_Pool_InitTyped (&types_pool, SCE_SMediaType);
     SCE_List_Init (&funs);
     SCE_List_SetFreeFunc (&funs, SCE_Media_DeleteType);
     return SCE_OK;
@@ -106,6 +109,7 @@ int SCE_Init_Media (void)
 void SCE_Quit_Media (void)
 {
     SCE_List_Clear (&funs);
+    SCE_Pool_Clear (&types_pool);
 }
 
 
@@ -17,13 +17,14 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 22/12/2006
-   updated: 14/05/2010 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
 
 #include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMath.h"  /* MIN() */
 #include "SCE/utils/SCEMemory.h"
 
 /**
@@ -46,9 +47,16 @@
 
 #define SCE_USE_MEMORY_MANAGER 1
 
-#define SCE_NUM_MEMORY_ARRAYS 128
-/* number of allocs per block */
-#define SCE_ARRAY_BLOCK_SIZE 128
+/* per-thread allocation statistics, never freed: allocations keep a pointer
+   to the record of the thread that made them */
+typedef struct SCE_SMemThread {
+    SCE_SMemThreadStats stats;
+    struct SCE_SMemThread *next;
+} SCE_SMemThread;
+
+/* initial number of buckets of the allocations hash table, must be a power
+   of two */
+#define SCE_MEM_HASH_SIZE 1024
 
 /**
  * \brief Stores metadata about memory blocks
@@ -59,72 +67,212 @@ typedef struct SCE_SMemAlloc {
     const char *file;
     unsigned int line;
     size_t size;
-    void *block; /* hack */
+    void *block;                 /* start of the memory if the descriptor
+                                    isn't, see SCE_Mem_DebugAllocAligned() */
     struct SCE_SMemAlloc *next, *prev;
+    struct SCE_SMemAlloc *hnext; /* next allocation in the same hash bucket */
+    SCE_SMemThread *thread;      /* thread that made the allocation */
 } SCE_SMemAlloc;
 
-/** \brief Table of all allocations */
-static SCE_SMemAlloc allocs = {
-    "root allocations list", 0, 0, NULL, NULL, NULL
-};
-static pthread_mutex_t allocs_m;
+/* size of the header preceding each tracked block, rounded up so that the
+   returned pointer keeps the alignment given by malloc() */
+#define SCE_MEM_HEADER_SIZE ((sizeof (SCE_SMemAlloc) + 15) & ~(size_t)15)
+
+/* the allocations are spread over several registries, each one having its
+   own lock, so that threads tracking allocations don't all wait for the
+   same mutex; must be a power of two */
+#define SCE_MEM_NUM_REGISTRIES 16
+
+/**
+ * \brief Table of allocations
+ */
+typedef struct SCE_SMemRegistry {
+    SCE_SMemAlloc allocs;       /* root of the list of allocations */
+    pthread_mutex_t mutex;
+    /* hash table indexing the allocations of \c allocs by address, so
+       that a pointer can be located without walking the whole list */
+    SCE_SMemAlloc **hash;
+    size_t hash_size;
+    size_t n_allocs;
+} SCE_SMemRegistry;
+
+static SCE_SMemRegistry registries[SCE_MEM_NUM_REGISTRIES];
 static pthread_mutexattr_t allocs_mattr;
 
 
+/* small allocations are served by arrays of fixed size slots, one array per
+   multiple of SCE_MEM_ARRAY_STEP bytes, big enough to hold a SCE_MEM_SMALL_SIZE
+   bytes block together with its debugging header */
+#define SCE_MEM_ARRAY_STEP 16
+#define SCE_NUM_MEMORY_ARRAYS\
+    ((SCE_MEM_SMALL_SIZE + SCE_MEM_HEADER_SIZE + SCE_MEM_ARRAY_STEP - 1) /\
+     SCE_MEM_ARRAY_STEP)
+#define SCE_MEM_MAX_ARRAY_SIZE (SCE_NUM_MEMORY_ARRAYS * SCE_MEM_ARRAY_STEP)
+
+/* the slots of an array are taken from blocks of SCE_ARRAY_BLOCK_SIZE bytes,
+   aligned on their size so that the block of a slot can be retrieved from
+   its address */
+#define SCE_ARRAY_BLOCK_SHIFT 16
+#define SCE_ARRAY_BLOCK_SIZE ((size_t)1 << SCE_ARRAY_BLOCK_SHIFT)
+
+typedef struct SCE_SMemArray SCE_SMemArray;
+
 typedef struct SCE_SMemArrayBlock {
-    SCE_SMemAlloc *allocs[SCE_ARRAY_BLOCK_SIZE];
-    SCE_SMemAlloc *freeallocs[SCE_ARRAY_BLOCK_SIZE];
-    int nfree;         /* number of free allocs in 'allocs' */
+    SCE_SMemArray *array;      /* array the block belongs to */
+    void *freeallocs;          /* singly linked list of freed slots */
+    size_t nslots;             /* total number of slots */
+    size_t ncarved;            /* number of slots ever handed out */
+    size_t nused;              /* number of slots currently in use */
+    int listed;                /* is the block in array's list? */
     struct SCE_SMemArrayBlock *next, *prev;
 } SCE_SMemArrayBlock;
 
+/* offset of the first slot of a block */
+#define SCE_ARRAY_BLOCK_HEADER_SIZE\
+    ((sizeof (SCE_SMemArrayBlock) + 63) & ~(size_t)63)
+
 /* structure d'un tableau contenant une suite d'allocations de la meme taille */
-typedef struct SCE_SMemArray {
+struct SCE_SMemArray {
     size_t alloc_size;         /* size of one allocation */
-    SCE_SMemArrayBlock *root;  /* root block */
-    SCE_SMemArrayBlock *last;  /* last block */
-} SCE_SMemArray;
+    SCE_SMemArrayBlock *root;  /* blocks having free slots */
+    SCE_SMemArrayBlock *empty; /* unused block kept to avoid trashing */
+    pthread_mutex_t mutex;
+};
 
 static SCE_SMemArray arrays[SCE_NUM_MEMORY_ARRAYS];
-static pthread_mutex_t arrays_m = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t mem_once = PTHREAD_ONCE_INIT;
+
+/* each thread keeps a magazine of free slots for every array, allocating
+   from and freeing to it without locking anything; the arrays are only
+   accessed to move half a magazine at once */
+#define SCE_MEM_MAGAZINE_SIZE 64
+
+typedef struct SCE_SMemCache {
+    unsigned int n[SCE_NUM_MEMORY_ARRAYS];
+    void *slots[SCE_NUM_MEMORY_ARRAYS][SCE_MEM_MAGAZINE_SIZE];
+} SCE_SMemCache;
 
-#define SCE_Mem_For(i) for ((i) = allocs.next; (i); (i) = (i)->next)
+static pthread_key_t cache_key;
+static int cache_key_ok = SCE_FALSE;
+
+
+/* statistics are kept per call site in a fixed size open addressing table,
+   looked up without locking; must be a power of two */
+#define SCE_MEM_NUM_SITES 4096
+
+typedef struct SCE_SMemSite {
+    const char *file;           /* NULL if the entry is free */
+    unsigned int line;
+    SCE_SMemCounters counters;
+} SCE_SMemSite;
+
+static SCE_SMemSite sites[SCE_MEM_NUM_SITES];
+static pthread_mutex_t sites_m = PTHREAD_MUTEX_INITIALIZER;
+/* used once the table is full */
+static SCE_SMemSite other_site = {"<other>", 0, {0, 0, 0, 0, 0}};
+
+static SCE_SMemCounters stats_counters;
+static size_t stats_histogram[SCE_MEM_HISTOGRAM_SIZE];
+
+static SCE_SMemThread *threads = NULL;
+static unsigned long n_threads = 0;
+/* used when a thread record can't be allocated */
+static SCE_SMemThread unknown_thread = {{0, SCE_FALSE, {0, 0, 0, 0, 0}}, NULL};
+static pthread_key_t thread_key;
+static int thread_key_ok = SCE_FALSE;
+
+/* bitmap of the addresses of all the blocks, in two levels: it tells whether
+   a pointer belongs to an array without locking anything */
+#define SCE_MEM_MAP_LEAF_SHIFT 20
+#define SCE_MEM_MAP_ROOT_SIZE 4096
+#define SCE_MEM_MAP_BITS (sizeof (unsigned long) * 8)
+
+static unsigned long *blocks_map[SCE_MEM_MAP_ROOT_SIZE];
+static pthread_mutex_t blocks_m = PTHREAD_MUTEX_INITIALIZER;
+
+#define SCE_Mem_For(r, i) for ((i) = (r)->allocs.next; (i); (i) = (i)->next)
+
+/* block a slot of an array belongs to */
+#define SCE_Mem_GetBlockFromAlloc(p)\
+    ((SCE_SMemArrayBlock*)((size_t)(p) & ~(SCE_ARRAY_BLOCK_SIZE - 1)))
 
 static void SCE_Mem_InitArray (SCE_SMemArray *a)
 {
     a->alloc_size = 1; /* hop */
     a->root = NULL;
-    a->last = NULL;
+    a->empty = NULL;
+    pthread_mutex_init (&a->mutex, NULL);
 }
 
-int SCE_Init_Mem (void)
+static void SCE_Mem_InitArrays (void)
 {
     size_t i;
     for (i = 0; i < SCE_NUM_MEMORY_ARRAYS; i++) {
         SCE_Mem_InitArray (&arrays[i]);
-        arrays[i].alloc_size = i + 1;
+        arrays[i].alloc_size = (i + 1) * SCE_MEM_ARRAY_STEP;
     }
+}
 
+static void SCE_Mem_InitRegistry (SCE_SMemRegistry *r)
+{
+    r->allocs.file = "root allocations list";
+    r->allocs.line = 0;
+    r->allocs.size = 0;
+    r->allocs.block = NULL;
+    r->allocs.next = r->allocs.prev = r->allocs.hnext = NULL;
+    r->allocs.thread = NULL;
 #if 0
     /* lol pthread_mutex_recursive is not defined. */
     pthread_mutexattr_init (&allocs_mattr);
     pthread_mutexattr_settype (&allocs_mattr, PTHREAD_MUTEX_RECURSIVE);
-    pthread_mutex_init (&allocs_m, &allocs_mattr);
+    pthread_mutex_init (&r->mutex, &allocs_mattr);
 #else
-    pthread_mutex_init (&allocs_m, NULL);
+    pthread_mutex_init (&r->mutex, NULL);
 #endif
+    r->hash = NULL;
+    r->hash_size = 0;
+    r->n_allocs = 0;
+}
+
+static void SCE_Mem_DeleteCache (void*);
+static void SCE_Mem_ExitThread (void*);
+
+static void SCE_Mem_InitStatic (void)
+{
+    size_t i;
+    SCE_Mem_InitArrays ();
+    for (i = 0; i < SCE_MEM_NUM_REGISTRIES; i++)
+        SCE_Mem_InitRegistry (&registries[i]);
+    /* without a key the arrays are simply accessed directly */
+    cache_key_ok = !pthread_key_create (&cache_key, SCE_Mem_DeleteCache);
+    thread_key_ok = !pthread_key_create (&thread_key, SCE_Mem_ExitThread);
+}
 
+static void SCE_Mem_DeleteBlock (SCE_SMemArrayBlock*);
+
+int SCE_Init_Mem (void)
+{
+    pthread_once (&mem_once, SCE_Mem_InitStatic);
     return SCE_OK;
 }
 void SCE_Quit_Mem (void)
 {
+    size_t i;
+    SCE_Mem_FlushCache ();
     /* tell the user: be sure the mutexes are unlocked */
-    pthread_mutex_destroy (&allocs_m);
-    pthread_mutex_destroy (&arrays_m);
-    /* safe further re-init, keep the data in the state we got them
-       at initialization */
-    pthread_mutex_init (&allocs_m, NULL);
-    pthread_mutex_init (&arrays_m, NULL);
+    for (i = 0; i < SCE_MEM_NUM_REGISTRIES; i++) {
+        pthread_mutex_destroy (&registries[i].mutex);
+        /* safe further re-init, keep the data in the state we got them
+           at initialization */
+        pthread_mutex_init (&registries[i].mutex, NULL);
+    }
+    /* blocks still in use must survive, only give back the spare ones */
+    for (i = 0; i < SCE_NUM_MEMORY_ARRAYS; i++) {
+        pthread_mutex_lock (&arrays[i].mutex);
+        SCE_Mem_DeleteBlock (arrays[i].empty);
+        arrays[i].empty = NULL;
+        pthread_mutex_unlock (&arrays[i].mutex);
+    }
 }
 
 static void SCE_Mem_InitAlloc (SCE_SMemAlloc *m)
@@ -134,47 +282,84 @@ static void SCE_Mem_InitAlloc (SCE_SMemAlloc *m)
     m->size = 0;
     m->block = NULL;
     m->next = m->prev = NULL;
+    m->hnext = NULL;
+    m->thread = NULL;
 }
 
-static void SCE_Mem_InitBlock (SCE_SMemArrayBlock *b)
+/* functions managing the map of the blocks */
+
+static int SCE_Mem_MapBlock (SCE_SMemArrayBlock *b, int set)
 {
-    unsigned int i;
-    for (i = 0; i < SCE_ARRAY_BLOCK_SIZE; i++) {
-        b->allocs[i] = NULL;
-        b->freeallocs[i] = NULL;
+    size_t key = (size_t)b >> SCE_ARRAY_BLOCK_SHIFT;
+    size_t root = key >> SCE_MEM_MAP_LEAF_SHIFT;
+    size_t bit = key & (((size_t)1 << SCE_MEM_MAP_LEAF_SHIFT) - 1);
+    unsigned long *leaf = NULL;
+
+    /* address out of the mapped range, this block can't be used */
+    if (root >= SCE_MEM_MAP_ROOT_SIZE)
+        return SCE_ERROR;
+
+    pthread_mutex_lock (&blocks_m);
+    if (!(leaf = blocks_map[root])) {
+        leaf = calloc (((size_t)1 << SCE_MEM_MAP_LEAF_SHIFT) / SCE_MEM_MAP_BITS,
+                       sizeof *leaf);
+        if (!leaf) {
+            pthread_mutex_unlock (&blocks_m);
+            return SCE_ERROR;
+        }
+        __atomic_store_n (&blocks_map[root], leaf, __ATOMIC_RELEASE);
     }
-    b->nfree = SCE_ARRAY_BLOCK_SIZE;
-    b->next = b->prev = NULL;
+    if (set)
+        __atomic_fetch_or (&leaf[bit / SCE_MEM_MAP_BITS],
+                           1UL << (bit % SCE_MEM_MAP_BITS), __ATOMIC_RELEASE);
+    else
+        __atomic_fetch_and (&leaf[bit / SCE_MEM_MAP_BITS],
+                            ~(1UL << (bit % SCE_MEM_MAP_BITS)),
+                            __ATOMIC_RELEASE);
+    pthread_mutex_unlock (&blocks_m);
+    return SCE_OK;
+}
+
+/* returns the block \p p was taken from, or NULL if it doesn't come from
+   an array */
+static SCE_SMemArrayBlock* SCE_Mem_LocateBlock (const void *p)
+{
+    size_t key = (size_t)p >> SCE_ARRAY_BLOCK_SHIFT;
+    size_t root = key >> SCE_MEM_MAP_LEAF_SHIFT;
+    size_t bit = key & (((size_t)1 << SCE_MEM_MAP_LEAF_SHIFT) - 1);
+    unsigned long *leaf = NULL;
+
+    if (root >= SCE_MEM_MAP_ROOT_SIZE)
+        return NULL;
+    if (!(leaf = __atomic_load_n (&blocks_map[root], __ATOMIC_ACQUIRE)))
+        return NULL;
+    if (!(__atomic_load_n (&leaf[bit / SCE_MEM_MAP_BITS], __ATOMIC_ACQUIRE) &
+          (1UL << (bit % SCE_MEM_MAP_BITS))))
+        return NULL;
+    return (SCE_SMemArrayBlock*)(key << SCE_ARRAY_BLOCK_SHIFT);
 }
 
 /* functions managing the arrays */
 
-static SCE_SMemArrayBlock* SCE_Mem_CreateBlock (size_t size)
+static SCE_SMemArrayBlock* SCE_Mem_CreateBlock (SCE_SMemArray *a)
 {
-    SCE_SMemArrayBlock *b = malloc (sizeof *b);
-    if (!b)
-        SCEE_Log (SCE_OUT_OF_MEMORY);
-    else {
-        size_t i;
-        void *address = NULL;
-        SCE_Mem_InitBlock (b);
-        /* allocate the data */
-        size += sizeof (SCE_SMemAlloc);
-        b->allocs[0] = malloc (size * SCE_ARRAY_BLOCK_SIZE);
-        if (!b->allocs[0]) {
-            SCEE_Log (SCE_OUT_OF_MEMORY);
-            free (b);
-            return NULL;
-        }
-        SCE_Mem_InitAlloc (b->allocs[0]);
-        b->allocs[0]->block = b;
-        for (i = 1; i < SCE_ARRAY_BLOCK_SIZE; i++) {
-            address = b->allocs[i-1];
-            address = (void*)((size_t)address + size);
-            b->freeallocs[i] = b->allocs[i] = address;
-            SCE_Mem_InitAlloc (b->allocs[i]);
-            b->allocs[i]->block = b;
-        }
+    SCE_SMemArrayBlock *b = NULL;
+    void *p = NULL;
+
+    if (posix_memalign (&p, SCE_ARRAY_BLOCK_SIZE, SCE_ARRAY_BLOCK_SIZE))
+        return NULL;
+    b = p;
+    b->array = a;
+    b->freeallocs = NULL;
+    b->nslots = (SCE_ARRAY_BLOCK_SIZE - SCE_ARRAY_BLOCK_HEADER_SIZE) /
+        a->alloc_size;
+    b->ncarved = 0;
+    b->nused = 0;
+    b->listed = SCE_FALSE;
+    b->next = b->prev = NULL;
+    if (SCE_Mem_MapBlock (b, SCE_TRUE) < 0) {
+        free (b);
+        return NULL;
     }
     return b;
 }
@@ -182,139 +367,657 @@ static SCE_SMemArrayBlock* SCE_Mem_CreateBlock (size_t size)
 static void SCE_Mem_DeleteBlock (SCE_SMemArrayBlock *b)
 {
     if (b) {
-        free (b->allocs[0]);
+        /* unmap it first: the memory may be given back by malloc() */
+        SCE_Mem_MapBlock (b, SCE_FALSE);
         free (b);
     }
 }
 
-static int SCE_Mem_AddNewBlock (SCE_SMemArray *a)
+static void SCE_Mem_ListBlock (SCE_SMemArray *a, SCE_SMemArrayBlock *b)
+{
+    b->prev = NULL;
+    b->next = a->root;
+    if (a->root)
+        a->root->prev = b;
+    a->root = b;
+    b->listed = SCE_TRUE;
+}
+
+static void SCE_Mem_UnlistBlock (SCE_SMemArray *a, SCE_SMemArrayBlock *b)
+{
+    if (b->prev)
+        b->prev->next = b->next;
+    else
+        a->root = b->next;
+    if (b->next)
+        b->next->prev = b->prev;
+    b->next = b->prev = NULL;
+    b->listed = SCE_FALSE;
+}
+
+/* the caller must hold the array's mutex */
+static void* SCE_Mem_GetNextAllocInBlock (SCE_SMemArrayBlock *b)
+{
+    void *p = NULL;
+    if (b->freeallocs) {
+        p = b->freeallocs;
+        b->freeallocs = *(void**)p;
+    } else {
+        /* slots are carved lazily, to avoid touching the whole block */
+        p = (char*)b + SCE_ARRAY_BLOCK_HEADER_SIZE +
+            b->ncarved * b->array->alloc_size;
+        b->ncarved++;
+    }
+    b->nused++;
+    return p;
+}
+
+/* the caller must hold the array's mutex */
+static void* SCE_Mem_GetNextAlloc (SCE_SMemArray *a)
+{
+    SCE_SMemArrayBlock *b = a->root;
+    void *p = NULL;
+
+    if (!b) {
+        if (a->empty) {
+            b = a->empty;
+            a->empty = NULL;
+        } else if (!(b = SCE_Mem_CreateBlock (a)))
+            return NULL;
+        SCE_Mem_ListBlock (a, b);
+    }
+    p = SCE_Mem_GetNextAllocInBlock (b);
+    if (b->nused == b->nslots)
+        SCE_Mem_UnlistBlock (a, b);
+    return p;
+}
+
+/* the caller must hold the array's mutex */
+static void SCE_Mem_EraseAllocFromBlock (SCE_SMemArrayBlock *b, void *p)
+{
+    SCE_SMemArray *a = b->array;
+
+    *(void**)p = b->freeallocs;
+    b->freeallocs = p;
+    if (!b->listed)
+        SCE_Mem_ListBlock (a, b);
+    b->nused--;
+    if (!b->nused) {
+        SCE_Mem_UnlistBlock (a, b);
+        if (!a->empty) {
+            /* start from a clean block */
+            b->freeallocs = NULL;
+            b->ncarved = 0;
+            a->empty = b;
+        } else
+            SCE_Mem_DeleteBlock (b);
+    }
+}
+
+static SCE_SMemArray* SCE_Mem_GetArray (size_t size)
+{
+    pthread_once (&mem_once, SCE_Mem_InitStatic);
+    if (!size)
+        size = 1;
+    return &arrays[(size - 1) / SCE_MEM_ARRAY_STEP];
+}
+
+
+/* functions managing the per-thread caches */
+
+static SCE_SMemCache* SCE_Mem_GetCache (void)
 {
-    if (pthread_mutex_lock (&arrays_m) == 0) {
-        if (!a->last) {
-            a->last = a->root = SCE_Mem_CreateBlock (a->alloc_size);
-            if (!a->last)
-                return -1;
-        } else {
-            a->last->next = SCE_Mem_CreateBlock (a->alloc_size);
-            if (!a->last->next)
-                return -1;
-            a->last->next->prev = a->last;
-            a->last = a->last->next;
+    SCE_SMemCache *c = NULL;
+    if (!cache_key_ok)
+        return NULL;
+    if (!(c = pthread_getspecific (cache_key))) {
+        /* not from the arrays: the cache must not depend on itself */
+        if (!(c = calloc (1, sizeof *c)))
+            return NULL;
+        if (pthread_setspecific (cache_key, c)) {
+            free (c);
+            return NULL;
         }
-        pthread_mutex_unlock (&arrays_m);
     }
-    return 0;
+    return c;
 }
 
-static void SCE_Mem_EraseBlock (SCE_SMemArray *a, SCE_SMemArrayBlock *b)
+/* takes half a magazine of slots from the array \p i */
+static void SCE_Mem_RefillCache (SCE_SMemCache *c, size_t i)
 {
-    if (pthread_mutex_lock (&arrays_m) == 0) {
-        if (b->prev)
-            b->prev->next = b->next;
-        else
-            a->root = b->next;
-        if (b->next)
-            b->next->prev = b->prev;
-        else
-            a->last = b->prev;
-        SCE_Mem_DeleteBlock (b);
-        pthread_mutex_unlock (&arrays_m);
+    SCE_SMemArray *a = &arrays[i];
+    void *p = NULL;
+    if (pthread_mutex_lock (&a->mutex) == 0) {
+        while (c->n[i] < SCE_MEM_MAGAZINE_SIZE / 2 &&
+               (p = SCE_Mem_GetNextAlloc (a)))
+            c->slots[i][c->n[i]++] = p;
+        pthread_mutex_unlock (&a->mutex);
     }
 }
 
-static SCE_SMemAlloc* SCE_Mem_GetNextAllocInBlock (SCE_SMemArrayBlock *b)
+/* gives back the \p n least recently freed slots of the magazine \p i */
+static void SCE_Mem_FlushCacheArray (SCE_SMemCache *c, size_t i,
+                                     unsigned int n)
 {
-#if 0
-    return (b->nfree ? b->freeallocs[--b->nfree] : NULL);
-#else
-    /* not secure, but this function is (for now) only called if nfree > 0 */
-    return b->freeallocs[--b->nfree];
-#endif
+    SCE_SMemArray *a = &arrays[i];
+    unsigned int j;
+    if (pthread_mutex_lock (&a->mutex) == 0) {
+        for (j = 0; j < n; j++) {
+            void *p = c->slots[i][j];
+            SCE_Mem_EraseAllocFromBlock (SCE_Mem_GetBlockFromAlloc (p), p);
+        }
+        pthread_mutex_unlock (&a->mutex);
+        c->n[i] -= n;
+        memmove (c->slots[i], &c->slots[i][n], c->n[i] * sizeof (void*));
+    }
 }
 
-static SCE_SMemAlloc* SCE_Mem_GetNextAlloc (SCE_SMemArray *a)
+static void SCE_Mem_DeleteCache (void *cache)
+{
+    SCE_SMemCache *c = cache;
+    size_t i;
+    for (i = 0; i < SCE_NUM_MEMORY_ARRAYS; i++) {
+        if (c->n[i])
+            SCE_Mem_FlushCacheArray (c, i, c->n[i]);
+    }
+    free (c);
+}
+
+/**
+ * \brief Gives the free slots cached by the calling thread back to the
+ * shared arrays
+ *
+ * The cache of a thread is flushed when it exits, this is only useful for a
+ * thread that has freed a lot of small blocks and lives long.
+ */
+void SCE_Mem_FlushCache (void)
+{
+    SCE_SMemCache *c = NULL;
+    if (cache_key_ok && (c = pthread_getspecific (cache_key))) {
+        pthread_setspecific (cache_key, NULL);
+        SCE_Mem_DeleteCache (c);
+    }
+}
+
+
+static void* SCE_Mem_NewAllocFromArray (size_t size)
+{
+    SCE_SMemArray *a = SCE_Mem_GetArray (size);
+    SCE_SMemCache *c = NULL;
+    size_t i = a - arrays;
+    void *p = NULL;
+
+    if (!(c = SCE_Mem_GetCache ())) {
+        if (pthread_mutex_lock (&a->mutex) == 0) {
+            p = SCE_Mem_GetNextAlloc (a);
+            pthread_mutex_unlock (&a->mutex);
+        }
+        return p;
+    }
+    if (!c->n[i])
+        SCE_Mem_RefillCache (c, i);
+    if (c->n[i])
+        p = c->slots[i][--c->n[i]];
+    return p;
+}
+
+static void SCE_Mem_EraseAllocFromArray (SCE_SMemArrayBlock *b, void *p)
+{
+    SCE_SMemArray *a = b->array;
+    SCE_SMemCache *c = NULL;
+    size_t i = a - arrays;
+
+    if (!(c = SCE_Mem_GetCache ())) {
+        if (pthread_mutex_lock (&a->mutex) == 0) {
+            SCE_Mem_EraseAllocFromBlock (b, p);
+            pthread_mutex_unlock (&a->mutex);
+        }
+        return;
+    }
+    if (c->n[i] == SCE_MEM_MAGAZINE_SIZE)
+        SCE_Mem_FlushCacheArray (c, i, SCE_MEM_MAGAZINE_SIZE / 2);
+    if (c->n[i] < SCE_MEM_MAGAZINE_SIZE)
+        c->slots[i][c->n[i]++] = p;
+    else if (pthread_mutex_lock (&a->mutex) == 0) {
+        SCE_Mem_EraseAllocFromBlock (b, p);
+        pthread_mutex_unlock (&a->mutex);
+    }
+}
+
+/**
+ * \brief Allocates memory without tracking it
+ * \param s Size wanted for the block
+ * \returns a pointer to a newly allocated block on succes, NULL on failure
+ *
+ * Blocks of at most SCE_MEM_SMALL_SIZE bytes are taken from arrays of fixed
+ * size slots, bigger ones come from malloc(). This is what SCE_malloc()
+ * calls when SCE_DEBUG is not defined.
+ * \sa SCE_Mem_RawFree(), SCE_Mem_Alloc()
+ */
+void* SCE_Mem_RawAlloc (size_t s)
+{
+    void *p = NULL;
+    if (s <= SCE_MEM_MAX_ARRAY_SIZE)
+        p = SCE_Mem_NewAllocFromArray (s);
+    /* fall back to malloc() if the arrays couldn't provide anything */
+    if (!p && !(p = malloc (s)))
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+    return p;
+}
+
+/**
+ * \brief Untracked version of SCE_Mem_Calloc()
+ * \sa SCE_Mem_RawAlloc()
+ */
+void* SCE_Mem_RawCalloc (size_t s, size_t n)
+{
+    void *p = NULL;
+    if (n && s > (size_t)-1 / n) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    if (s * n > SCE_MEM_MAX_ARRAY_SIZE) {
+        if (!(p = calloc (s, n)))
+            SCEE_Log (SCE_OUT_OF_MEMORY);
+    } else if ((p = SCE_Mem_RawAlloc (s * n)))
+        memset (p, 0, s * n);
+    return p;
+}
+
+/**
+ * \brief Untracked version of SCE_Mem_Realloc()
+ * \sa SCE_Mem_RawAlloc()
+ */
+void* SCE_Mem_RawRealloc (void *p, size_t s)
 {
-    SCE_SMemAlloc *alloc = NULL;
     SCE_SMemArrayBlock *b = NULL;
-    b = a->last;
-    if (pthread_mutex_lock (&arrays_m) == 0) {
-        while (b && !b->nfree)
-            b = b->prev;
-        if (b)
-            alloc = SCE_Mem_GetNextAllocInBlock (b);
-        /* TODO: use recursive mutex */
-        pthread_mutex_unlock (&arrays_m);
+    void *new = NULL;
+
+    if (!p)
+        return SCE_Mem_RawAlloc (s);
+
+    if (!(b = SCE_Mem_LocateBlock (p))) {
+        if (!(new = realloc (p, s)) && s)
+            SCEE_Log (SCE_OUT_OF_MEMORY);
+        return new;
     }
-    return NULL;
+
+    /* the slot is already of the right size */
+    if (s <= b->array->alloc_size && s > b->array->alloc_size -
+        SCE_MEM_ARRAY_STEP)
+        return p;
+
+    if (!(new = SCE_Mem_RawAlloc (s)))
+        return NULL;
+    memcpy (new, p, MIN (s, b->array->alloc_size));
+    SCE_Mem_EraseAllocFromArray (b, p);
+    return new;
 }
 
-static SCE_SMemAlloc* SCE_Mem_NewAllocFromArray (size_t size)
+/**
+ * \brief Frees a block allocated by SCE_Mem_RawAlloc()
+ * \param p the block to free, can be NULL
+ *
+ * Also accepts blocks allocated by malloc().
+ */
+void SCE_Mem_RawFree (void *p)
 {
-    SCE_SMemAlloc *m = NULL;
-    /* considers this function is called with a good size */
-    SCE_SMemArray *a = &arrays[size-1];
-    if (!(m = SCE_Mem_GetNextAlloc (a))) {
-        if (!(SCE_Mem_AddNewBlock (a) < 0))
-            m = SCE_Mem_GetNextAlloc (a); /* can't fail */
+    SCE_SMemArrayBlock *b = NULL;
+    if (!p)
+        return;
+    if ((b = SCE_Mem_LocateBlock (p)))
+        SCE_Mem_EraseAllocFromArray (b, p);
+    else
+        free (p);
+}
+
+
+/* functions managing the statistics */
+
+static void SCE_Mem_ExitThread (void *thread)
+{
+    SCE_SMemThread *t = thread;
+    __atomic_store_n (&t->stats.alive, SCE_FALSE, __ATOMIC_RELAXED);
+}
+
+static SCE_SMemThread* SCE_Mem_GetThread (void)
+{
+    SCE_SMemThread *t = NULL;
+
+    pthread_once (&mem_once, SCE_Mem_InitStatic);
+    if (!thread_key_ok)
+        return &unknown_thread;
+    if ((t = pthread_getspecific (thread_key)))
+        return t;
+
+    /* not from the arrays, they may be the ones being accounted */
+    if (!(t = calloc (1, sizeof *t)))
+        return &unknown_thread;
+    if (pthread_setspecific (thread_key, t)) {
+        free (t);
+        return &unknown_thread;
     }
-    return m;
+    t->stats.id = __atomic_add_fetch (&n_threads, 1, __ATOMIC_RELAXED);
+    t->stats.alive = SCE_TRUE;
+    t->next = __atomic_load_n (&threads, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n (&threads, &t->next, t, SCE_TRUE,
+                                         __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    return t;
+}
+
+static SCE_SMemSite* SCE_Mem_GetSite (const char *file, unsigned int line)
+{
+    size_t h, i, n;
+    const char *f = NULL;
+
+    h = ((size_t)file >> 3) * 31 + line;
+    h *= (size_t)2654435761u;
+    h ^= h >> 15;
+
+    /* entries are never removed: a free one ends the probing */
+    for (n = 0, i = h; n < SCE_MEM_NUM_SITES; n++, i++) {
+        SCE_SMemSite *site = &sites[i & (SCE_MEM_NUM_SITES - 1)];
+        if (!(f = __atomic_load_n (&site->file, __ATOMIC_ACQUIRE)))
+            break;
+        if (f == file && site->line == line)
+            return site;
+    }
+    if (n == SCE_MEM_NUM_SITES)
+        return &other_site;
+
+    /* insert it, the entry may have been taken in the meantime */
+    pthread_mutex_lock (&sites_m);
+    for (; n < SCE_MEM_NUM_SITES; n++, i++) {
+        SCE_SMemSite *site = &sites[i & (SCE_MEM_NUM_SITES - 1)];
+        if (!(f = site->file)) {
+            site->line = line;
+            __atomic_store_n (&site->file, file, __ATOMIC_RELEASE);
+            pthread_mutex_unlock (&sites_m);
+            return site;
+        }
+        if (f == file && site->line == line) {
+            pthread_mutex_unlock (&sites_m);
+            return site;
+        }
+    }
+    pthread_mutex_unlock (&sites_m);
+    return &other_site;
+}
+
+static void SCE_Mem_AddToCounters (SCE_SMemCounters *c, size_t size)
+{
+    size_t live, peak;
+    live = __atomic_add_fetch (&c->live_bytes, size, __ATOMIC_RELAXED);
+    peak = __atomic_load_n (&c->peak_bytes, __ATOMIC_RELAXED);
+    while (live > peak &&
+           !__atomic_compare_exchange_n (&c->peak_bytes, &peak, live, SCE_TRUE,
+                                         __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    __atomic_add_fetch (&c->total_bytes, size, __ATOMIC_RELAXED);
+    __atomic_add_fetch (&c->n_allocs, 1, __ATOMIC_RELAXED);
+}
+
+static void SCE_Mem_SubFromCounters (SCE_SMemCounters *c, size_t size)
+{
+    __atomic_sub_fetch (&c->live_bytes, size, __ATOMIC_RELAXED);
+    __atomic_add_fetch (&c->n_frees, 1, __ATOMIC_RELAXED);
+}
+
+static void SCE_Mem_AccountAlloc (SCE_SMemSite *site, SCE_SMemThread *thread,
+                                  size_t size)
+{
+    unsigned int bucket = 0;
+    if (size) {
+        bucket = sizeof (unsigned long) * 8 - __builtin_clzl (size);
+        if (bucket >= SCE_MEM_HISTOGRAM_SIZE)
+            bucket = SCE_MEM_HISTOGRAM_SIZE - 1;
+    }
+    __atomic_add_fetch (&stats_histogram[bucket], 1, __ATOMIC_RELAXED);
+    SCE_Mem_AddToCounters (&stats_counters, size);
+    SCE_Mem_AddToCounters (&site->counters, size);
+    SCE_Mem_AddToCounters (&thread->stats.counters, size);
 }
 
-static void SCE_Mem_EraseAllocFromArray (SCE_SMemAlloc *m)
+static void SCE_Mem_AccountFree (SCE_SMemSite *site, SCE_SMemThread *thread,
+                                 size_t size)
 {
-    SCE_SMemArrayBlock *b = m->block;
-    b->freeallocs[b->nfree++] = m;
-    if (b->nfree >= SCE_ARRAY_BLOCK_SIZE)
-        SCE_Mem_EraseBlock (&arrays[m->size-1], b);
-    SCE_Mem_InitAlloc (m);
+    SCE_Mem_SubFromCounters (&stats_counters, size);
+    SCE_Mem_SubFromCounters (&site->counters, size);
+    SCE_Mem_SubFromCounters (&thread->stats.counters, size);
 }
 
+
+/* header of the blocks allocated by SCE_Mem_StatAlloc() */
+typedef struct SCE_SMemStatHeader {
+    SCE_SMemSite *site;
+    SCE_SMemThread *thread;
+    size_t size;
+} SCE_SMemStatHeader;
+
+#define SCE_MEM_STAT_HEADER_SIZE\
+    ((sizeof (SCE_SMemStatHeader) + 15) & ~(size_t)15)
+
+#define SCE_Mem_GetStatHeader(p)\
+    ((SCE_SMemStatHeader*)((char*)(p) - SCE_MEM_STAT_HEADER_SIZE))
+
+/**
+ * \brief Allocates memory and keeps statistics about it
+ * \param file, line where the block is asked
+ * \param s size wanted for the block
+ *
+ * This is what SCE_malloc() calls when SCE_MEM_STATS is defined and
+ * SCE_DEBUG is not. The block must be freed with SCE_Mem_StatFree().
+ * \sa SCE_Mem_GetStats(), SCE_Mem_RawAlloc()
+ */
+void* SCE_Mem_StatAlloc (const char *file, unsigned int line, size_t s)
+{
+    SCE_SMemStatHeader *h = NULL;
+
+    if (s > (size_t)-1 - SCE_MEM_STAT_HEADER_SIZE) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    if (!(h = SCE_Mem_RawAlloc (SCE_MEM_STAT_HEADER_SIZE + s))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    h->site = SCE_Mem_GetSite (file, line);
+    h->thread = SCE_Mem_GetThread ();
+    h->size = s;
+    SCE_Mem_AccountAlloc (h->site, h->thread, s);
+    return (char*)h + SCE_MEM_STAT_HEADER_SIZE;
+}
+
+/**
+ * \brief Statistics keeping version of SCE_Mem_Calloc()
+ * \sa SCE_Mem_StatAlloc()
+ */
+void* SCE_Mem_StatCalloc (const char *file, unsigned int line, size_t s,
+                          size_t n)
+{
+    void *p = NULL;
+    if (n && s > (size_t)-1 / n) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    if ((p = SCE_Mem_StatAlloc (file, line, s * n)))
+        memset (p, 0, s * n);
+    return p;
+}
+
+/**
+ * \brief Statistics keeping version of SCE_Mem_Realloc()
+ *
+ * The block is accounted as freed from its previous call site and allocated
+ * again from \p file and \p line.
+ * \sa SCE_Mem_StatAlloc()
+ */
+void* SCE_Mem_StatRealloc (const char *file, unsigned int line, void *p,
+                           size_t s)
+{
+    SCE_SMemStatHeader *h = NULL, old;
+
+    if (!p)
+        return SCE_Mem_StatAlloc (file, line, s);
+    if (s > (size_t)-1 - SCE_MEM_STAT_HEADER_SIZE) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    old = *SCE_Mem_GetStatHeader (p);
+    if (!(h = SCE_Mem_RawRealloc (SCE_Mem_GetStatHeader (p),
+                                  SCE_MEM_STAT_HEADER_SIZE + s))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    SCE_Mem_AccountFree (old.site, old.thread, old.size);
+    h->site = SCE_Mem_GetSite (file, line);
+    h->thread = SCE_Mem_GetThread ();
+    h->size = s;
+    SCE_Mem_AccountAlloc (h->site, h->thread, s);
+    return (char*)h + SCE_MEM_STAT_HEADER_SIZE;
+}
+
+/**
+ * \brief Frees a block allocated by SCE_Mem_StatAlloc()
+ * \param p the block to free, can be NULL
+ */
+void SCE_Mem_StatFree (void *p)
+{
+    SCE_SMemStatHeader *h = NULL;
+    if (p) {
+        h = SCE_Mem_GetStatHeader (p);
+        SCE_Mem_AccountFree (h->site, h->thread, h->size);
+        SCE_Mem_RawFree (h);
+    }
+}
+
+
 /* functions managing the table of allocations */
 
 static SCE_SMemAlloc* SCE_Mem_NewAlloc (size_t size)
 {
     SCE_SMemAlloc *m = NULL;
-#if 0
-    if (size <= SCE_NUM_MEMORY_ARRAYS)
-        m = SCE_Mem_NewAllocFromArray (size);
-    else
-#endif
-    {
-        /* make one allocation for all: descriptor and demanded block */
-        m = malloc (sizeof *m + size);
-        if (!m)
-            SCEE_Log (SCE_OUT_OF_MEMORY);
-        else
-            SCE_Mem_InitAlloc (m);
-    }
+    /* make one allocation for all: descriptor and demanded block */
+    m = SCE_Mem_RawAlloc (SCE_MEM_HEADER_SIZE + size);
+    if (m)
+        SCE_Mem_InitAlloc (m);
     return m;
 }
 
 static void SCE_Mem_DeleteAlloc (SCE_SMemAlloc *m)
 {
-    free (m);
+    SCE_Mem_RawFree (m->block ? m->block : m);
 }
 
-#define SCE_Mem_GetAllocAddress(m) ((void*)&((SCE_SMemAlloc*)(m))[1])
+#define SCE_Mem_GetAllocAddress(m) ((void*)((char*)(m) + SCE_MEM_HEADER_SIZE))
+#define SCE_Mem_GetAllocFromAddress(p)\
+    ((SCE_SMemAlloc*)((char*)(p) - SCE_MEM_HEADER_SIZE))
 
 
-static SCE_SMemAlloc* SCE_Mem_LocateAllocFromPointer (void *p)
+static size_t SCE_Mem_Hash (const SCE_SMemAlloc *m, size_t size)
+{
+    size_t h = (size_t)m >> 4;
+    h *= (size_t)2654435761u;
+    h ^= h >> 15;
+    return h & (size - 1);
+}
+
+/* registry in charge of \p m */
+static SCE_SMemRegistry* SCE_Mem_GetRegistry (const SCE_SMemAlloc *m)
+{
+    size_t h = (size_t)m >> 4;
+    h ^= h >> 8;
+    return &registries[h & (SCE_MEM_NUM_REGISTRIES - 1)];
+}
+
+/* doubles the size of the hash table, the caller must hold r->mutex */
+static void SCE_Mem_GrowHash (SCE_SMemRegistry *r)
+{
+    SCE_SMemAlloc **hash = NULL;
+    size_t i, size;
+
+    size = r->hash_size ? r->hash_size * 2 : SCE_MEM_HASH_SIZE;
+    /* if it fails, we just keep using the current table with longer chains */
+    if (!(hash = calloc (size, sizeof *hash)))
+        return;
+    for (i = 0; i < r->hash_size; i++) {
+        SCE_SMemAlloc *m = r->hash[i], *next = NULL;
+        while (m) {
+            size_t h = SCE_Mem_Hash (m, size);
+            next = m->hnext;
+            m->hnext = hash[h];
+            hash[h] = m;
+            m = next;
+        }
+    }
+    free (r->hash);
+    r->hash = hash;
+    r->hash_size = size;
+}
+
+/* the caller must hold r->mutex */
+static SCE_SMemAlloc* SCE_Mem_Lookup (SCE_SMemRegistry *r,
+                                      const SCE_SMemAlloc *m)
 {
     SCE_SMemAlloc *i = NULL;
-    SCE_SMemAlloc *al = p;
-    if (pthread_mutex_lock (&allocs_m) == 0) {
-        al = &al[-1];
-        SCE_Mem_For (i) {
-            if (i == al) {
-                pthread_mutex_unlock (&allocs_m);
+    if (r->hash_size) {
+        for (i = r->hash[SCE_Mem_Hash (m, r->hash_size)]; i; i = i->hnext) {
+            if (i == m)
                 return i;
-            }
         }
-        pthread_mutex_unlock (&allocs_m);
     }
     return NULL;
 }
 
+/* the caller must hold r->mutex */
+static void SCE_Mem_Register (SCE_SMemRegistry *r, SCE_SMemAlloc *m)
+{
+    size_t h;
+
+    if (r->n_allocs >= r->hash_size)
+        SCE_Mem_GrowHash (r);
+
+    m->prev = &r->allocs;
+    m->next = r->allocs.next;
+    if (m->next)
+        m->next->prev = m;
+    r->allocs.next = m;
+
+    h = SCE_Mem_Hash (m, r->hash_size);
+    m->hnext = r->hash[h];
+    r->hash[h] = m;
+    r->n_allocs++;
+}
+
+/* the caller must hold r->mutex and \p m must be registered */
+static void SCE_Mem_Unregister (SCE_SMemRegistry *r, SCE_SMemAlloc *m)
+{
+    SCE_SMemAlloc **i = NULL;
+
+    m->prev->next = m->next;
+    if (m->next)
+        m->next->prev = m->prev;
+
+    i = &r->hash[SCE_Mem_Hash (m, r->hash_size)];
+    while (*i != m)
+        i = &(*i)->hnext;
+    *i = m->hnext;
+    r->n_allocs--;
+}
+
+
+static SCE_SMemAlloc* SCE_Mem_LocateAllocFromPointer (void *p)
+{
+    SCE_SMemAlloc *m = SCE_Mem_GetAllocFromAddress (p);
+    SCE_SMemRegistry *r = SCE_Mem_GetRegistry (m);
+    pthread_once (&mem_once, SCE_Mem_InitStatic);
+    if (pthread_mutex_lock (&r->mutex) == 0) {
+        m = SCE_Mem_Lookup (r, m);
+        pthread_mutex_unlock (&r->mutex);
+    } else
+        m = NULL;
+    return m;
+}
+
 
 int SCE_Mem_IsValid (void *p)
 {
@@ -324,31 +1027,28 @@ int SCE_Mem_IsValid (void *p)
 
 static void SCE_Mem_AddAlloc (SCE_SMemAlloc *m)
 {
-    m->prev = &allocs;
+    SCE_SMemRegistry *r = SCE_Mem_GetRegistry (m);
     /* FIXME: errors not checked! */
-    if (pthread_mutex_lock (&allocs_m) == 0) {
-        m->next = allocs.next;
-        if (m->next)
-            m->next->prev = m;
-        allocs.next = m;
-        pthread_mutex_unlock (&allocs_m);
+    if (pthread_mutex_lock (&r->mutex) == 0) {
+        SCE_Mem_Register (r, m);
+        pthread_mutex_unlock (&r->mutex);
     }
 }
 
-static void SCE_Mem_EraseAlloc (SCE_SMemAlloc *m)
+/* removes the allocation \p p belongs to from the table and returns it,
+   or returns NULL if \p p wasn't allocated by SCE_Mem_Alloc() */
+static SCE_SMemAlloc* SCE_Mem_EraseAlloc (void *p)
 {
-    if (pthread_mutex_lock (&allocs_m) == 0) {
-        m->prev->next = m->next;
-        if (m->next)
-            m->next->prev = m->prev;
-#if 0
-        if (m->size <= SCE_NUM_MEMORY_ARRAYS)
-            SCE_Mem_EraseAllocFromArray (m);
-        else
-#endif
-        SCE_Mem_DeleteAlloc (m);
-        pthread_mutex_unlock (&allocs_m);
-    }
+    SCE_SMemAlloc *m = SCE_Mem_GetAllocFromAddress (p);
+    SCE_SMemRegistry *r = SCE_Mem_GetRegistry (m);
+    pthread_once (&mem_once, SCE_Mem_InitStatic);
+    if (pthread_mutex_lock (&r->mutex) == 0) {
+        if ((m = SCE_Mem_Lookup (r, m)))
+            SCE_Mem_Unregister (r, m);
+        pthread_mutex_unlock (&r->mutex);
+    } else
+        m = NULL;
+    return m;
 }
 
 
@@ -384,8 +1084,10 @@ void* SCE_Mem_Alloc (const char *file, unsigned int line, size_t s)
     mem->file = file;
     mem->line = line;
     mem->size = s;
+    mem->thread = SCE_Mem_GetThread ();
 
     SCE_Mem_AddAlloc (mem);
+    SCE_Mem_AccountAlloc (SCE_Mem_GetSite (file, line), mem->thread, s);
 
     return SCE_Mem_GetAllocAddress (mem);
 #endif
@@ -433,8 +1135,6 @@ void* SCE_Mem_Calloc (const char *file, unsigned int line, size_t s, size_t n)
  * You will generally want to call SCE_realloc() that wraps this function.
  * 
  * \see SCE_realloc()
- * \todo this function doesn't work
- * \warning this function doesn't work, do not use it
  */
 void* SCE_Mem_Realloc (const char *file, unsigned int line, void *p, size_t s)
 {
@@ -446,33 +1146,41 @@ void* SCE_Mem_Realloc (const char *file, unsigned int line, void *p, size_t s)
         SCEE_Log (SCE_OUT_OF_MEMORY);
     return p;
 #else
-    SCE_SMemAlloc *mem = NULL;
+    SCE_SMemAlloc *mem = NULL, *new = NULL, old;
 
     if (!p)
         return SCE_Mem_Alloc (file, line, s); /* nouvelle allocation */
-    else {
-        mem = SCE_Mem_LocateAllocFromPointer (p);
-        if (!mem) {
-            SCEE_Log (SCE_INVALID_POINTER);
-            return NULL;
-        }
-        mem = realloc (mem, sizeof *mem + s);
-        if (!mem) {
-            /* en cas d'echec realloc conserve la memoire deja alloue,
-               donc on ne libere aucune memoire */
-            SCEE_Log (SCE_OUT_OF_MEMORY);
-            return NULL;
-        }
-        if (mem->prev)
-            mem->prev->next = mem;
-        if (mem->next)
-            mem->next->prev = mem;
-        mem->size = s;
-        mem->line = line;
-        mem->file = file;
+
+    /* the address of the descriptor may change, unregister it first */
+    if (!(mem = SCE_Mem_EraseAlloc (p))) {
+        SCEE_Log (SCE_INVALID_POINTER);
+        return NULL;
+    }
+    if (mem->block) {
+        SCE_Mem_AddAlloc (mem);
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("can't reallocate an aligned block");
+        return NULL;
     }
+    old = *mem;
+    new = SCE_Mem_RawRealloc (mem, SCE_MEM_HEADER_SIZE + s);
+    if (!new) {
+        /* en cas d'echec realloc conserve la memoire deja alloue,
+           donc on ne libere aucune memoire */
+        SCE_Mem_AddAlloc (mem);
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    new->size = s;
+    new->line = line;
+    new->file = file;
+    new->thread = SCE_Mem_GetThread ();
+    SCE_Mem_AddAlloc (new);
+    SCE_Mem_AccountFree (SCE_Mem_GetSite (old.file, old.line), old.thread,
+                         old.size);
+    SCE_Mem_AccountAlloc (SCE_Mem_GetSite (file, line), new->thread, s);
 
-    return SCE_Mem_GetAllocAddress (mem);
+    return SCE_Mem_GetAllocAddress (new);
 #endif
 }
 
@@ -492,9 +1200,12 @@ void SCE_Mem_Free (const char *file, int line, void *p)
     free (p);
 #else
     if (p) {
-        SCE_SMemAlloc *m = SCE_Mem_LocateAllocFromPointer (p);
-        if (m && m != &allocs)
-            SCE_Mem_EraseAlloc (m);
+        SCE_SMemAlloc *m = SCE_Mem_EraseAlloc (p);
+        if (m) {
+            SCE_Mem_AccountFree (SCE_Mem_GetSite (m->file, m->line),
+                                 m->thread, m->size);
+            SCE_Mem_DeleteAlloc (m);
+        }
         else
             SCEE_SendMsg ("SCE_Mem_Free(): trying to free an invalid pointer %p"
                           " at %s(%d).\n", p, file, line);
@@ -503,6 +1214,102 @@ void SCE_Mem_Free (const char *file, int line, void *p)
 }
 
 
+static int SCE_Mem_CheckAlignment (size_t *align)
+{
+    if (!*align || (*align & (*align - 1))) {
+        SCEE_Log (SCE_INVALID_ARG);
+        SCEE_LogMsg ("alignment %zu isn't a power of two", *align);
+        return SCE_ERROR;
+    }
+    /* required by posix_memalign() */
+    if (*align < sizeof (void*))
+        *align = sizeof (void*);
+    return SCE_OK;
+}
+
+/**
+ * \brief Allocates memory aligned on a given boundary, without tracking it
+ * \param align the alignment, in bytes, must be a power of two
+ * \param s size wanted for the block
+ * \returns a pointer to a newly allocated block on succes, NULL on failure
+ *
+ * The block must be freed with SCE_Mem_FreeAligned(). You will generally want
+ * to call SCE_malloc_aligned() that wraps this function.
+ * \sa SCE_Mem_DebugAllocAligned()
+ */
+void* SCE_Mem_AllocAligned (size_t align, size_t s)
+{
+    void *p = NULL;
+    if (SCE_Mem_CheckAlignment (&align) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    if (posix_memalign (&p, align, s ? s : 1)) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    return p;
+}
+
+/**
+ * \brief Frees a block allocated by SCE_Mem_AllocAligned()
+ * \param p the block to free, can be NULL
+ */
+void SCE_Mem_FreeAligned (void *p)
+{
+    free (p);
+}
+
+/**
+ * \brief Tracked version of SCE_Mem_AllocAligned()
+ * \param file, line where the block is asked
+ * \param align the alignment, in bytes, must be a power of two
+ * \param s size wanted for the block
+ *
+ * The block is freed by SCE_Mem_Free() and can't be reallocated.
+ * SCE_malloc_aligned() calls this function when SCE_DEBUG is defined.
+ * \sa SCE_Mem_Alloc()
+ */
+void* SCE_Mem_DebugAllocAligned (const char *file, unsigned int line,
+                                 size_t align, size_t s)
+{
+    SCE_SMemAlloc *mem = NULL;
+    void *p = NULL;
+    size_t addr;
+
+    if (SCE_Mem_CheckAlignment (&align) < 0) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    /* the headers keep the 16 bytes alignment of the arrays and malloc() */
+    if (align <= 16)
+        return SCE_Mem_Alloc (file, line, s);
+
+    if (s > (size_t)-1 - SCE_MEM_HEADER_SIZE - align) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    if (!(p = SCE_Mem_RawAlloc (SCE_MEM_HEADER_SIZE + align + s))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    /* put the descriptor right before the aligned address */
+    addr = ((size_t)p + SCE_MEM_HEADER_SIZE + align - 1) & ~(align - 1);
+    mem = SCE_Mem_GetAllocFromAddress (addr);
+    SCE_Mem_InitAlloc (mem);
+    mem->block = p;
+    mem->file = file;
+    mem->line = line;
+    mem->size = s;
+    mem->thread = SCE_Mem_GetThread ();
+
+    SCE_Mem_AddAlloc (mem);
+    SCE_Mem_AccountAlloc (SCE_Mem_GetSite (file, line), mem->thread, s);
+
+    return SCE_Mem_GetAllocAddress (mem);
+}
+
+
 /**
  * \brief Duplicates allocated memory and copies its content
  * \param p the memory to duplicate
@@ -524,16 +1331,170 @@ void* SCE_Mem_Dup (const void *p, size_t size)
 void SCE_Mem_List (void)
 {
     unsigned int n = 0;
+    size_t i;
     SCE_SMemAlloc *a = NULL;
-    SCE_Mem_For (a) {
-        SCEE_SendMsg ("- allocation in %s (%u): %zu bytes.\n",
-                      a->file, a->line, a->size);
-        n++;
+    pthread_once (&mem_once, SCE_Mem_InitStatic);
+    for (i = 0; i < SCE_MEM_NUM_REGISTRIES; i++) {
+        pthread_mutex_lock (&registries[i].mutex);
+        SCE_Mem_For (&registries[i], a) {
+            SCEE_SendMsg ("- allocation in %s (%u): %zu bytes.\n",
+                          a->file, a->line, a->size);
+            n++;
+        }
+        pthread_mutex_unlock (&registries[i].mutex);
     }
     SCEE_SendMsg ("you have %u non-freeds allocations.\n", n);
 }
 
 
+
+static void SCE_Mem_CopyCounters (SCE_SMemCounters *dst,
+                                  SCE_SMemCounters *src)
+{
+    dst->live_bytes = __atomic_load_n (&src->live_bytes, __ATOMIC_RELAXED);
+    dst->peak_bytes = __atomic_load_n (&src->peak_bytes, __ATOMIC_RELAXED);
+    dst->total_bytes = __atomic_load_n (&src->total_bytes, __ATOMIC_RELAXED);
+    dst->n_allocs = __atomic_load_n (&src->n_allocs, __ATOMIC_RELAXED);
+    dst->n_frees = __atomic_load_n (&src->n_frees, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Gets the global allocation statistics
+ * \param stats where to store the statistics
+ *
+ * Statistics are only kept when the library is built with SCE_DEBUG or
+ * SCE_MEM_STATS defined (see the configure option --enable-memory-stats),
+ * otherwise every counter is 0. The counters are read one by one while
+ * other threads may keep allocating, they are not an atomic snapshot.
+ * \sa SCE_Mem_GetSiteStats(), SCE_Mem_GetThreadStats(), SCE_Mem_DumpStats()
+ */
+void SCE_Mem_GetStats (SCE_SMemStats *stats)
+{
+    size_t i;
+    SCE_Mem_CopyCounters (&stats->counters, &stats_counters);
+    for (i = 0; i < SCE_MEM_HISTOGRAM_SIZE; i++)
+        stats->histogram[i] = __atomic_load_n (&stats_histogram[i],
+                                               __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Gets the allocation statistics of every call site
+ * \param stats array where to store the statistics, can be NULL
+ * \param n size of \p stats
+ * \returns the number of call sites, which may be bigger than \p n
+ * \sa SCE_Mem_GetStats()
+ */
+size_t SCE_Mem_GetSiteStats (SCE_SMemSiteStats *stats, size_t n)
+{
+    size_t i, n_sites = 0;
+    const char *file = NULL;
+
+    for (i = 0; i <= SCE_MEM_NUM_SITES; i++) {
+        SCE_SMemSite *site = i < SCE_MEM_NUM_SITES ? &sites[i] : &other_site;
+        if (!(file = __atomic_load_n (&site->file, __ATOMIC_ACQUIRE)))
+            continue;
+        if (site == &other_site && !site->counters.n_allocs)
+            continue;
+        if (stats && n_sites < n) {
+            stats[n_sites].file = file;
+            stats[n_sites].line = site->line;
+            SCE_Mem_CopyCounters (&stats[n_sites].counters, &site->counters);
+        }
+        n_sites++;
+    }
+    return n_sites;
+}
+
+/**
+ * \brief Gets the allocation statistics of every thread that ever allocated
+ * \param stats array where to store the statistics, can be NULL
+ * \param n size of \p stats
+ * \returns the number of threads, which may be bigger than \p n
+ *
+ * The bytes allocated by a thread and freed by another one are still
+ * accounted to the first one.
+ * \sa SCE_Mem_GetStats()
+ */
+size_t SCE_Mem_GetThreadStats (SCE_SMemThreadStats *stats, size_t n)
+{
+    size_t n_threads = 0;
+    SCE_SMemThread *t = NULL;
+
+    t = __atomic_load_n (&threads, __ATOMIC_ACQUIRE);
+    for (; t; t = t->next) {
+        if (stats && n_threads < n) {
+            stats[n_threads].id = t->stats.id;
+            stats[n_threads].alive = __atomic_load_n (&t->stats.alive,
+                                                      __ATOMIC_RELAXED);
+            SCE_Mem_CopyCounters (&stats[n_threads].counters,
+                                  &t->stats.counters);
+        }
+        n_threads++;
+    }
+    return n_threads;
+}
+
+static int SCE_Mem_DumpCounters (FILE *fp, const SCE_SMemCounters *c)
+{
+    return fprintf (fp, "\t%zu\t%zu\t%zu\t%zu\t%zu\n", c->live_bytes,
+                    c->peak_bytes, c->total_bytes, c->n_allocs, c->n_frees);
+}
+
+/**
+ * \brief Writes the allocation statistics as tab separated values
+ * \param fp stream to write to
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ *
+ * Every line starts with its kind: \c global, \c hist (upper bound of the
+ * bucket, in bytes, and count), \c site (file and line) or \c thread (id
+ * and whether it is alive). The counters follow, in the order of
+ * SCE_SMemCounters. Lines starting with '#' are comments.
+ * \sa SCE_Mem_GetStats()
+ */
+int SCE_Mem_DumpStats (FILE *fp)
+{
+    SCE_SMemStats stats;
+    SCE_SMemSiteStats site;
+    SCE_SMemThreadStats thread;
+    SCE_SMemThread *t = NULL;
+    size_t i;
+    int err = 0;
+
+    SCE_Mem_GetStats (&stats);
+    err |= fprintf (fp, "# kind\t...\tlive\tpeak\ttotal\tallocs\tfrees\n");
+    err |= fprintf (fp, "global");
+    err |= SCE_Mem_DumpCounters (fp, &stats.counters);
+    for (i = 0; i < SCE_MEM_HISTOGRAM_SIZE; i++) {
+        if (stats.histogram[i])
+            err |= fprintf (fp, "hist\t%zu\t%zu\n",
+                            i ? ((size_t)1 << i) - 1 : 0, stats.histogram[i]);
+    }
+    for (i = 0; i <= SCE_MEM_NUM_SITES; i++) {
+        SCE_SMemSite *s = i < SCE_MEM_NUM_SITES ? &sites[i] : &other_site;
+        if (!(site.file = __atomic_load_n (&s->file, __ATOMIC_ACQUIRE)))
+            continue;
+        site.line = s->line;
+        SCE_Mem_CopyCounters (&site.counters, &s->counters);
+        if (!site.counters.n_allocs)
+            continue;
+        err |= fprintf (fp, "site\t%s\t%u", site.file, site.line);
+        err |= SCE_Mem_DumpCounters (fp, &site.counters);
+    }
+    for (t = __atomic_load_n (&threads, __ATOMIC_ACQUIRE); t; t = t->next) {
+        thread.id = t->stats.id;
+        thread.alive = __atomic_load_n (&t->stats.alive, __ATOMIC_RELAXED);
+        SCE_Mem_CopyCounters (&thread.counters, &t->stats.counters);
+        err |= fprintf (fp, "thread\t%lu\t%d", thread.id, thread.alive);
+        err |= SCE_Mem_DumpCounters (fp, &thread.counters);
+    }
+    if (err < 0 || fflush (fp)) {
+        SCEE_LogErrno ("failed to write memory statistics");
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+
 /**
  * \brief Get the size used by a pointer
  */
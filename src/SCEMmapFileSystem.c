@@ -0,0 +1,407 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEMath.h"  /* MIN() */
+#include "SCE/utils/SCEMmapFileSystem.h"
+
+/**
+ * \file SCEMmapFileSystem.c
+ * \copydoc mmapfs
+ * \brief Memory mapped file system
+ *
+ * \file SCEMmapFileSystem.h
+ * \copydoc mmapfs
+ * \brief Memory mapped file system
+ */
+
+/**
+ * \defgroup mmapfs Memory mapped file system
+ * \ingroup utils
+ *
+ * sce_mmapfs maps the whole file in memory when it is opened: reading is a
+ * memcpy() from the mapping and SCE_File_Map() gives the mapping itself,
+ * without any copy. Writing past the end of a file grows the mapping by
+ * half its size at least, the file is trimmed to its actual length when
+ * it is closed.
+ */
+
+/** @{ */
+
+SCE_SFileSystem sce_mmapfs;
+
+typedef struct xfile xfile;
+struct xfile {
+    int fd;
+    unsigned char *data;        /* NULL when nothing is mapped */
+    size_t size;                /* length of the file */
+    size_t mapped;              /* length of the mapping, >= size */
+    size_t pos;
+    int readable;
+    int writable;
+};
+
+static const unsigned char empty = 0;
+
+
+/* maps \p mapped bytes of the file, which must be long enough */
+static int xremap (xfile *file, size_t mapped)
+{
+    int prot = PROT_READ;
+    void *p = NULL;
+
+    if (file->data) {
+        munmap (file->data, file->mapped);
+        file->data = NULL;
+    }
+    file->mapped = 0;
+    if (!mapped)
+        return SCE_OK;          /* mmap() refuses empty mappings */
+
+    if (file->writable)
+        prot |= PROT_WRITE;
+    p = mmap (NULL, mapped, prot, MAP_SHARED, file->fd, 0);
+    if (p == MAP_FAILED) {
+        SCEE_LogErrno ("mmap()");
+        return SCE_ERROR;
+    }
+    file->data = p;
+    file->mapped = mapped;
+    return SCE_OK;
+}
+
+/* the bytes between size and mapped are kept zeroed, so that growing the
+   file within the mapping gives zeros like ftruncate() does */
+static int xresize (xfile *file, size_t size)
+{
+    size_t mapped;
+
+    if (size <= file->mapped) {
+        if (size < file->size)
+            memset (&file->data[size], 0, file->size - size);
+    } else {
+        mapped = file->mapped + file->mapped / 2;
+        if (mapped < size || mapped < file->mapped)
+            mapped = size;
+        if (ftruncate (file->fd, mapped) < 0) {
+            SCEE_LogErrno ("ftruncate()");
+            return SCE_ERROR;
+        }
+        if (xremap (file, mapped) < 0) {
+            SCEE_LogSrc ();
+            file->size = file->pos = 0;
+            return SCE_ERROR;
+        }
+    }
+    file->size = size;
+    if (file->pos > file->size)
+        file->pos = file->size;
+    return SCE_OK;
+}
+
+static void* xopen (SCE_SFileSystem *fs, const char *fname, int flags)
+{
+    xfile *file = NULL;
+    struct stat st;
+    int oflags;
+
+    (void)fs;
+
+    /* same semantic as sce_cfs */
+    if ((flags & SCE_FILE_READ) && (flags & SCE_FILE_WRITE)) {
+        oflags = O_RDWR;
+        if (flags & SCE_FILE_TRUNCATE)
+            oflags |= O_CREAT | O_TRUNC;
+    } else if (flags & SCE_FILE_READ)
+        oflags = O_RDONLY;
+    else if (flags & SCE_FILE_WRITE)
+        /* a writable shared mapping needs read access */
+        oflags = O_RDWR | O_CREAT | O_TRUNC;
+    else {
+        SCEE_Log (SCE_INVALID_ARG);
+        SCEE_LogMsg ("invalid flags parameter");
+        return NULL;
+    }
+    if (flags & SCE_FILE_CREATE)
+        oflags |= O_CREAT;
+
+    if (!(file = SCE_malloc (sizeof *file))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    file->data = NULL;
+    file->size = file->mapped = file->pos = 0;
+    file->readable = flags & SCE_FILE_READ;
+    file->writable = flags & SCE_FILE_WRITE;
+
+    if ((file->fd = open (fname, oflags, 0666)) < 0) {
+        SCEE_LogErrno (fname);
+        SCE_free (file);
+        return NULL;
+    }
+    if (fstat (file->fd, &st) < 0) {
+        SCEE_LogErrno (fname);
+        goto fail;
+    }
+    if (xremap (file, st.st_size) < 0)
+        goto fail;
+    file->size = st.st_size;
+
+    return file;
+fail:
+    SCEE_LogSrc ();
+    close (file->fd);
+    SCE_free (file);
+    return NULL;
+}
+
+static int xclose (void *fd)
+{
+    int r = 0;
+    xfile *file = fd;
+    if (file->data)
+        munmap (file->data, file->mapped);
+    /* drop what was mapped ahead */
+    if (file->mapped > file->size && ftruncate (file->fd, file->size) < 0) {
+        SCEE_LogErrno ("ftruncate()");
+        r = EOF;
+    }
+    if (close (file->fd))
+        r = EOF;
+    SCE_free (file);
+    return r;
+}
+
+static size_t xread (void *data, size_t size, size_t nmemb, void *fd)
+{
+    size_t s;
+    xfile *file = fd;
+
+    if (!file->readable || !size)
+        return 0;
+    s = MIN (size * nmemb, file->size - file->pos);
+    memcpy (data, &file->data[file->pos], s);
+    file->pos += s;
+    return s / size;
+}
+
+static size_t xwrite (const void *data, size_t size, size_t nmemb, void *fd)
+{
+    size_t s = size * nmemb;
+    xfile *file = fd;
+
+    if (!file->writable || !s)
+        return 0;
+    if (s > file->size - file->pos) {
+        if (xresize (file, file->pos + s) < 0) {
+            SCEE_LogSrc ();
+            return 0;
+        }
+    }
+    memcpy (&file->data[file->pos], data, s);
+    file->pos += s;
+    return nmemb;
+}
+
+static size_t xpread (void *data, size_t size, size_t nmemb, long offset,
+                      void *fd)
+{
+    size_t s;
+    xfile *file = fd;
+
+    if (!file->readable || !size || offset < 0 ||
+        (size_t)offset >= file->size)
+        return 0;
+    s = MIN (size * nmemb, file->size - offset);
+    memcpy (data, &file->data[offset], s);
+    return s / size;
+}
+
+static size_t xpwrite (const void *data, size_t size, size_t nmemb,
+                       long offset, void *fd)
+{
+    size_t s = size * nmemb;
+    xfile *file = fd;
+
+    if (!file->writable || !s || offset < 0)
+        return 0;
+    if (offset + s > file->size) {
+        if (xresize (file, offset + s) < 0) {
+            SCEE_LogSrc ();
+            return 0;
+        }
+    }
+    memcpy (&file->data[offset], data, s);
+    return nmemb;
+}
+
+static size_t xreadv (const SCE_SFileIOVec *v, size_t n, void *fd)
+{
+    size_t i, s, done = 0;
+    xfile *file = fd;
+
+    if (!file->readable)
+        return 0;
+    for (i = 0; i < n && file->pos < file->size; i++) {
+        s = MIN (v[i].size, file->size - file->pos);
+        memcpy (v[i].data, &file->data[file->pos], s);
+        file->pos += s;
+        done += s;
+    }
+    return done;
+}
+
+static size_t xwritev (const SCE_SFileIOVec *v, size_t n, void *fd)
+{
+    size_t i, total = 0;
+    xfile *file = fd;
+
+    if (!file->writable)
+        return 0;
+    for (i = 0; i < n; i++)
+        total += v[i].size;
+    if (!total)
+        return 0;
+    /* remap once for all the buffers */
+    if (total > file->size - file->pos) {
+        if (xresize (file, file->pos + total) < 0) {
+            SCEE_LogSrc ();
+            return 0;
+        }
+    }
+    for (i = 0; i < n; i++) {
+        memcpy (&file->data[file->pos], v[i].data, v[i].size);
+        file->pos += v[i].size;
+    }
+    return total;
+}
+
+static int xseek (void *fd, long offset, int whence)
+{
+    long new;
+    xfile *file = fd;
+
+    switch (whence) {
+    case SEEK_SET: new = offset; break;
+    case SEEK_CUR: new = (long)file->pos + offset; break;
+    case SEEK_END: new = (long)file->size + offset; break;
+    default:
+        SCEE_Log (SCE_INVALID_ARG);
+        return -1;
+    }
+
+    if (new < 0)
+        new = 0;
+    else if (new > (long)file->size)
+        new = (long)file->size;
+    file->pos = (size_t)new;
+
+    return 0;
+}
+
+static long xtell (void *fd)
+{
+    xfile *file = fd;
+    return file->pos;
+}
+
+static void xrewind (void *fd)
+{
+    xfile *file = fd;
+    file->pos = 0;
+}
+
+static int xflush (void *fd)
+{
+    /* the mapping is shared, other readers see the writes already; the file
+       may look longer to them until it is closed though */
+    (void)fd;
+    return 0;
+}
+
+static int xtruncate (SCE_SFile *fp, size_t size)
+{
+    xfile *file = SCE_File_Get (fp);
+    if (!file->writable) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("can't truncate a read-only file");
+        return SCE_ERROR;
+    }
+    if (xresize (file, size) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+static size_t xlength (const void *fd)
+{
+    const xfile *file = fd;
+    return file->size;
+}
+
+static const void* xmap (void *fd, size_t *size)
+{
+    xfile *file = fd;
+    if (!file->readable) {
+        SCEE_Log (SCE_INVALID_OPERATION);
+        SCEE_LogMsg ("file was not opened for reading");
+        return NULL;
+    }
+    *size = file->size;
+    return file->data ? file->data : &empty;
+}
+
+
+int SCE_Init_MmapFS (void)
+{
+    sce_mmapfs.udata = NULL;
+    sce_mmapfs.subfs = NULL;
+    sce_mmapfs.xinit = NULL;
+    sce_mmapfs.xopen = xopen;
+    sce_mmapfs.xclose = xclose;
+    sce_mmapfs.xread = xread;
+    sce_mmapfs.xwrite = xwrite;
+    sce_mmapfs.xseek = xseek;
+    sce_mmapfs.xtell = xtell;
+    sce_mmapfs.xrewind = xrewind;
+    sce_mmapfs.xflush = xflush;
+    sce_mmapfs.xtruncate = xtruncate;
+    sce_mmapfs.xlength = xlength;
+    sce_mmapfs.xmap = xmap;
+    sce_mmapfs.xunmap = NULL;   /* the mapping lives as long as the file */
+    sce_mmapfs.xpread = xpread;
+    sce_mmapfs.xpwrite = xpwrite;
+    sce_mmapfs.xreadv = xreadv;
+    sce_mmapfs.xwritev = xwritev;
+    return SCE_OK;
+}
+void SCE_Quit_MmapFS (void)
+{
+}
+
+/** @} */
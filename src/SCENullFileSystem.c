@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 22/02/2013
-   updated: 22/02/2013 */
+   updated: 17/10/2026 */
 
 #include "SCE/utils/SCEUtils.h"
 #include "SCE/utils/SCENullFileSystem.h"
@@ -45,6 +45,27 @@ static size_t xwrite (const void *data, size_t size, size_t nmemb, void *fd)
 {
     return size * nmemb;
 }
+static size_t xpread (void *data, size_t size, size_t nmemb, long offset,
+                      void *fd)
+{
+    return 0;
+}
+static size_t xpwrite (const void *data, size_t size, size_t nmemb,
+                       long offset, void *fd)
+{
+    return nmemb;
+}
+static size_t xreadv (const SCE_SFileIOVec *v, size_t n, void *fd)
+{
+    return 0;
+}
+static size_t xwritev (const SCE_SFileIOVec *v, size_t n, void *fd)
+{
+    size_t i, size = 0;
+    for (i = 0; i < n; i++)
+        size += v[i].size;
+    return size;
+}
 static int xseek (void *fd, long offset, int whence)
 {
     return 0;
@@ -64,6 +85,12 @@ static size_t xlength (const void *f)
 {
     return 0;
 }
+static const void* xmap (void *fd, size_t *size)
+{
+    static const char empty = 0;
+    *size = 0;
+    return &empty;
+}
 
 int SCE_Init_NullFS (void)
 {
@@ -80,6 +107,12 @@ int SCE_Init_NullFS (void)
     sce_nullfs.xflush = xflush;
     sce_nullfs.xtruncate = xtruncate;
     sce_nullfs.xlength = xlength;
+    sce_nullfs.xmap = xmap;
+    sce_nullfs.xunmap = NULL;
+    sce_nullfs.xpread = xpread;
+    sce_nullfs.xpwrite = xpwrite;
+    sce_nullfs.xreadv = xreadv;
+    sce_nullfs.xwritev = xwritev;
     return SCE_OK;
 }
 void SCE_Quit_NullFS (void)
@@ -0,0 +1,197 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <pthread.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEPool.h"
+
+/**
+ * \file SCEPool.c
+ * \copydoc pool
+ * \brief Pools of fixed size elements
+ *
+ * \file SCEPool.h
+ * \copydoc pool
+ * \brief Pools of fixed size elements
+ */
+
+/**
+ * \defgroup pool Pools of fixed size elements
+ * \ingroup utils
+ *
+ * A pool gives out elements of one size, taken from chunks of several
+ * elements. Freed elements are kept in a free list and reused, chunks are
+ * only given back when the pool is cleared.
+ */
+
+/** @{ */
+
+/* chunks start with a pointer to the next one, padded so that the elements
+   keep malloc()'s alignment */
+#define SCE_POOL_CHUNK_HEADER_SIZE 16
+
+/**
+ * \brief Initializes a pool
+ * \param size size of the elements, in bytes
+ *
+ * The pool isn't thread safe by default.
+ * \sa SCE_Pool_InitTyped(), SCE_Pool_SetThreadSafe()
+ */
+void SCE_Pool_Init (SCE_SPool *p, size_t size)
+{
+    /* a free element stores the next one */
+    if (size < sizeof (void*))
+        size = sizeof (void*);
+    if (size >= 16)
+        size = (size + 15) & ~(size_t)15;
+    else
+        size = (size + sizeof (void*) - 1) & ~(sizeof (void*) - 1);
+    p->elt_size = size;
+    p->chunk_size = SCE_POOL_DEFAULT_CHUNK_SIZE;
+    p->chunks = NULL;
+    p->freeelts = NULL;
+    p->n_used = 0;
+    p->threadsafe = SCE_FALSE;
+}
+/**
+ * \brief Frees all the memory of a pool
+ *
+ * Every element taken from the pool becomes invalid.
+ */
+void SCE_Pool_Clear (SCE_SPool *p)
+{
+    void *c = p->chunks, *next = NULL;
+    while (c) {
+        next = *(void**)c;
+        SCE_free (c);
+        c = next;
+    }
+    p->chunks = NULL;
+    p->freeelts = NULL;
+    p->n_used = 0;
+    SCE_Pool_SetThreadSafe (p, SCE_FALSE);
+}
+
+/**
+ * \brief Sets the number of elements of the chunks allocated by a pool
+ */
+void SCE_Pool_SetChunkSize (SCE_SPool *p, size_t n)
+{
+    p->chunk_size = n ? n : 1;
+}
+/**
+ * \brief Defines whether a pool can be used by several threads at once
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_Pool_SetThreadSafe (SCE_SPool *p, int threadsafe)
+{
+    if (threadsafe && !p->threadsafe) {
+        if (pthread_mutex_init (&p->mutex, NULL)) {
+            SCEE_Log (SCE_INVALID_OPERATION);
+            SCEE_LogMsg ("failed to initialize the mutex of a pool");
+            return SCE_ERROR;
+        }
+    } else if (!threadsafe && p->threadsafe)
+        pthread_mutex_destroy (&p->mutex);
+    p->threadsafe = threadsafe;
+    return SCE_OK;
+}
+
+static int SCE_Pool_Grow (SCE_SPool *p)
+{
+    unsigned char *c = NULL, *elt = NULL;
+    size_t i;
+
+    if (p->chunk_size > ((size_t)-1 - SCE_POOL_CHUNK_HEADER_SIZE) /
+        p->elt_size) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return SCE_ERROR;
+    }
+    if (!(c = SCE_malloc (SCE_POOL_CHUNK_HEADER_SIZE +
+                          p->chunk_size * p->elt_size))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    *(void**)c = p->chunks;
+    p->chunks = c;
+
+    /* the first element of the chunk ends up first in the free list */
+    elt = c + SCE_POOL_CHUNK_HEADER_SIZE + p->chunk_size * p->elt_size;
+    for (i = 0; i < p->chunk_size; i++) {
+        elt -= p->elt_size;
+        *(void**)elt = p->freeelts;
+        p->freeelts = elt;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Takes an element from a pool
+ * \returns a pointer to an uninitialized element or NULL on error
+ * \sa SCE_Pool_New(), SCE_Pool_Free()
+ */
+void* SCE_Pool_Alloc (SCE_SPool *p)
+{
+    void *elt = NULL;
+
+    if (p->threadsafe)
+        pthread_mutex_lock (&p->mutex);
+    if (p->freeelts || SCE_Pool_Grow (p) == SCE_OK) {
+        elt = p->freeelts;
+        p->freeelts = *(void**)elt;
+        p->n_used++;
+    }
+    if (p->threadsafe)
+        pthread_mutex_unlock (&p->mutex);
+    if (!elt)
+        SCEE_LogSrc ();
+    return elt;
+}
+
+/**
+ * \brief Gives an element back to its pool
+ * \param elt an element taken from \p p, can be NULL
+ * \sa SCE_Pool_Alloc()
+ */
+void SCE_Pool_Free (SCE_SPool *p, void *elt)
+{
+    if (!elt)
+        return;
+    if (p->threadsafe)
+        pthread_mutex_lock (&p->mutex);
+    *(void**)elt = p->freeelts;
+    p->freeelts = elt;
+    p->n_used--;
+    if (p->threadsafe)
+        pthread_mutex_unlock (&p->mutex);
+}
+
+/**
+ * \brief Gets the number of elements currently taken from a pool
+ */
+size_t SCE_Pool_GetNumUsed (const SCE_SPool *p)
+{
+    return p->n_used;
+}
+
+/** @} */
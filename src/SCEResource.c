@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 02/01/2007
-   updated: 31/08/2010 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -26,6 +26,7 @@
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEString.h"
 #include "SCE/utils/SCEList.h"
+#include "SCE/utils/SCEPool.h"
 #include "SCE/utils/SCEMedia.h"
 #include "SCE/utils/SCEResource.h"
 
@@ -73,6 +74,10 @@ struct sce_sresource
 static SCE_SList resources_type;
 static SCE_SList resources;
 
+/* storage of the structures above */
+static SCE_SPool types_pool;
+static SCE_SPool resources_pool;
+
 static int res_type_id = 0;     /* type 0 is unused */
 
 
@@ -88,7 +93,7 @@ static void SCE_Resource_InitType (SCE_SResourceType *r)
 static SCE_SResourceType* SCE_Resource_CreateType (void)
 {
     SCE_SResourceType *res = NULL;
-    if (!(res = SCE_malloc (sizeof *res)))
+    if (!(res = SCE_Pool_New (&types_pool, SCE_SResourceType)))
         SCEE_LogSrc ();
     else
         SCE_Resource_InitType (res);
@@ -98,7 +103,7 @@ static void SCE_Resource_DeleteType (void *r)
 {
     if (r) {
         SCE_SResourceType *res = r;
-        SCE_free (res);
+        SCE_Pool_Free (&types_pool, res);
     }
 }
 
@@ -114,7 +119,7 @@ static void SCE_Resource_Init (SCE_SResource *r)
 static SCE_SResource* SCE_Resource_Create (void)
 {
     SCE_SResource *res = NULL;
-    res = SCE_malloc (sizeof *res);
+    res = SCE_Pool_New (&resources_pool, SCE_SResource);
     if (!res)
         SCEE_LogSrc ();
     else
@@ -126,7 +131,7 @@ static void SCE_Resource_Delete (void *r)
     if (r) {
         SCE_SResource *res = r;
         SCE_free (res->name);
-        SCE_free (res);
+        SCE_Pool_Free (&resources_pool, res);
     }
 }
 
@@ -139,8 +144,11 @@ static void SCE_Resource_Delete (void *r)
 int SCE_Init_Resource (void)
 {
     res_type_id = 0;
+    SCE_Pool_InitTyped (&types_pool, SCE_SResourceType);
+    SCE_Pool_InitTyped (&resources_pool, SCE_SResource);
     SCE_List_Init (&resources);
     SCE_List_SetFreeFunc (&resources, SCE_Resource_Delete);
+    SCE_List_SetCounted (&resources, SCE_TRUE);
     SCE_List_Init (&resources_type);
     SCE_List_SetFreeFunc (&resources_type, SCE_Resource_DeleteType);
     return SCE_OK;
@@ -152,6 +160,8 @@ void SCE_Quit_Resource (void)
 {
     SCE_List_Clear (&resources);
     SCE_List_Clear (&resources_type);
+    SCE_Pool_Clear (&resources_pool);
+    SCE_Pool_Clear (&types_pool);
     res_type_id = 0;
 }
 
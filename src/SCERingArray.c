@@ -0,0 +1,287 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <string.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEMath.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCERingArray.h"
+
+/**
+ * \file SCERingArray.c
+ * \copydoc ringarray
+ * \brief Circular byte buffers
+ *
+ * \file SCERingArray.h
+ * \copydoc ringarray
+ * \brief Circular byte buffers
+ */
+
+/**
+ * \defgroup ringarray Circular byte buffers
+ * \ingroup utils
+ *
+ * A ring array stores bytes in a circular buffer, bytes can be added and
+ * removed at both ends in constant time, which makes it a cheap FIFO. The
+ * content may wrap around the end of the storage, it is then seen as two
+ * spans, see SCE_RingArray_GetSpans() and SCE_RingArray_Linearize().
+ */
+
+/** @{ */
+
+#define SCE_RING_ARRAY_MIN_CAPACITY 16
+
+/* offset in the storage of the byte at \p i from the head */
+#define SCE_RingArray_Offset(r, i) (((r)->head + (i)) & ((r)->capacity - 1))
+
+void SCE_RingArray_Init (SCE_SRingArray *r)
+{
+    r->ptr = NULL;
+    r->head = 0;
+    r->size = 0;
+    r->capacity = 0;
+}
+void SCE_RingArray_Clear (SCE_SRingArray *r)
+{
+    SCE_free (r->ptr);
+}
+
+/* copies \p n bytes from \p i bytes after the head into \p dst */
+static void SCE_RingArray_CopyOut (const SCE_SRingArray *r, size_t i,
+                                   void *dst, size_t n)
+{
+    size_t offset = SCE_RingArray_Offset (r, i);
+    size_t first = MIN (n, r->capacity - offset);
+    memcpy (dst, &r->ptr[offset], first);
+    memcpy ((unsigned char*)dst + first, r->ptr, n - first);
+}
+
+/* copies \p n bytes of \p src at \p i bytes after the head, 0 if NULL */
+static void SCE_RingArray_CopyIn (SCE_SRingArray *r, size_t i,
+                                  const void *src, size_t n)
+{
+    size_t offset = SCE_RingArray_Offset (r, i);
+    size_t first = MIN (n, r->capacity - offset);
+    if (src) {
+        memcpy (&r->ptr[offset], src, first);
+        memcpy (r->ptr, (const unsigned char*)src + first, n - first);
+    } else {
+        memset (&r->ptr[offset], 0, first);
+        memset (r->ptr, 0, n - first);
+    }
+}
+
+/* moves the content into a new storage of \p capacity bytes, at its start */
+static int SCE_RingArray_Realloc (SCE_SRingArray *r, size_t capacity)
+{
+    unsigned char *ptr = NULL;
+    if (!(ptr = SCE_malloc (capacity))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    if (r->size)
+        SCE_RingArray_CopyOut (r, 0, ptr, r->size);
+    SCE_free (r->ptr);
+    r->ptr = ptr;
+    r->head = 0;
+    r->capacity = capacity;
+    return SCE_OK;
+}
+
+/**
+ * \brief Makes sure a ring array can hold \p size bytes without reallocating
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_RingArray_Reserve (SCE_SRingArray *r, size_t size)
+{
+    size_t capacity = r->capacity ? r->capacity : SCE_RING_ARRAY_MIN_CAPACITY;
+
+    if (size <= r->capacity)
+        return SCE_OK;
+    while (capacity < size) {
+        if (capacity > (size_t)-1 / 2) {
+            SCEE_Log (SCE_OUT_OF_MEMORY);
+            return SCE_ERROR;
+        }
+        capacity *= 2;
+    }
+    if (SCE_RingArray_Realloc (r, capacity) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+static int SCE_RingArray_Grow (SCE_SRingArray *r, size_t n)
+{
+    if (r->size + n < n) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return SCE_ERROR;
+    }
+    if (SCE_RingArray_Reserve (r, r->size + n) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    return SCE_OK;
+}
+
+/**
+ * \brief Adds bytes at the end of a ring array
+ * \param data bytes to add, if NULL zeroes are added
+ * \param n number of bytes
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_RingArray_PushBack (SCE_SRingArray *r, const void *data, size_t n)
+{
+    if (!n)
+        return SCE_OK;
+    if (SCE_RingArray_Grow (r, n) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    SCE_RingArray_CopyIn (r, r->size, data, n);
+    r->size += n;
+    return SCE_OK;
+}
+/**
+ * \brief Adds bytes at the beginning of a ring array
+ * \param data bytes to add, if NULL zeroes are added
+ * \param n number of bytes
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_RingArray_PushFront (SCE_SRingArray *r, const void *data, size_t n)
+{
+    if (!n)
+        return SCE_OK;
+    if (SCE_RingArray_Grow (r, n) < 0) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    r->head = (r->head - n) & (r->capacity - 1);
+    SCE_RingArray_CopyIn (r, 0, data, n);
+    r->size += n;
+    return SCE_OK;
+}
+
+/**
+ * \brief Removes bytes from the beginning of a ring array
+ * \param data where to copy the removed bytes, can be NULL
+ * \param n number of bytes to remove
+ * \returns the number of bytes removed, less than \p n if the ring array
+ * doesn't hold that many
+ */
+size_t SCE_RingArray_PopFront (SCE_SRingArray *r, void *data, size_t n)
+{
+    n = MIN (n, r->size);
+    if (data && n)
+        SCE_RingArray_CopyOut (r, 0, data, n);
+    r->size -= n;
+    /* an empty ring can start over from the beginning of its storage */
+    r->head = r->size ? SCE_RingArray_Offset (r, n) : 0;
+    return n;
+}
+/**
+ * \brief Removes bytes from the end of a ring array
+ * \param data where to copy the removed bytes, can be NULL
+ * \param n number of bytes to remove
+ * \returns the number of bytes removed
+ * \sa SCE_RingArray_PopFront()
+ */
+size_t SCE_RingArray_PopBack (SCE_SRingArray *r, void *data, size_t n)
+{
+    n = MIN (n, r->size);
+    if (data && n)
+        SCE_RingArray_CopyOut (r, r->size - n, data, n);
+    r->size -= n;
+    if (!r->size)
+        r->head = 0;
+    return n;
+}
+
+/**
+ * \brief Copies bytes out of a ring array without removing them
+ * \param offset offset of the first byte to copy from the beginning
+ * \param data where to copy the bytes
+ * \param n number of bytes to copy
+ * \returns the number of bytes copied
+ */
+size_t SCE_RingArray_Read (const SCE_SRingArray *r, size_t offset,
+                           void *data, size_t n)
+{
+    if (offset >= r->size)
+        return 0;
+    n = MIN (n, r->size - offset);
+    if (n)
+        SCE_RingArray_CopyOut (r, offset, data, n);
+    return n;
+}
+
+/**
+ * \brief Gets the content of a ring array as two contiguous spans
+ * \param p1, n1 receive the first span, NULL and 0 if the array is empty
+ * \param p2, n2 receive the second span, NULL and 0 if the content doesn't
+ * wrap around
+ * \returns the number of non empty spans
+ *
+ * The pointers are valid until the next call modifying the array.
+ */
+unsigned int SCE_RingArray_GetSpans (const SCE_SRingArray *r, void **p1,
+                                     size_t *n1, void **p2, size_t *n2)
+{
+    size_t first = MIN (r->size, r->capacity - r->head);
+    *p1 = first ? &r->ptr[r->head] : NULL;
+    *n1 = first;
+    *p2 = r->size > first ? r->ptr : NULL;
+    *n2 = r->size - first;
+    return (first != 0) + (*n2 != 0);
+}
+
+/**
+ * \brief Makes the content of a ring array contiguous
+ * \returns a pointer to the content, NULL if the array is empty or on error
+ *
+ * Costs a copy of the content only if it wraps around the end of the
+ * storage.
+ */
+void* SCE_RingArray_Linearize (SCE_SRingArray *r)
+{
+    if (!r->size)
+        return NULL;
+    if (r->head + r->size > r->capacity) {
+        if (SCE_RingArray_Realloc (r, r->capacity) < 0) {
+            SCEE_LogSrc ();
+            return NULL;
+        }
+    }
+    return &r->ptr[r->head];
+}
+
+size_t SCE_RingArray_GetSize (const SCE_SRingArray *r)
+{
+    return r->size;
+}
+size_t SCE_RingArray_GetCapacity (const SCE_SRingArray *r)
+{
+    return r->capacity;
+}
+
+/** @} */
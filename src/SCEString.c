@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
  
 /* created: 28/02/2007
-   updated: 20/08/2010 */
+   updated: 17/10/2026 */
 
 #include <stdlib.h>
 #include <ctype.h>
@@ -38,6 +38,7 @@
 
 #include "SCE/utils/SCEError.h"
 #include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEArena.h"
 #include "SCE/utils/SCEMath.h"
 
 #include "SCE/utils/SCEString.h"
@@ -449,6 +450,81 @@ char* SCE_String_CatDupMulti (const char* str, ...)
     return new;
 }
 
+/**
+ * \brief Duplicates a string into an arena
+ * \param arena the arena to allocate from
+ * \param src the string to copy
+ * \returns the duplication of \p src or NULL on error or if \p src is NULL
+ * \sa SCE_String_Dup(), SCE_Arena_Alloc()
+ */
+char* SCE_String_DupArena (SCE_SArena *arena, const char *src)
+{
+    char *new = NULL;
+    if (src && !(new = SCE_Arena_Dup (arena, src, strlen (src) + 1)))
+        SCEE_LogSrc ();
+    return new;
+}
+
+/**
+ * \brief Duplicates the concatenation of two strings into an arena
+ * \sa SCE_String_CatDup(), SCE_String_DupArena()
+ */
+char* SCE_String_CatDupArena (SCE_SArena *arena, const char *a, const char *b)
+{
+    size_t la = a ? strlen (a) : 0;
+    size_t lb = b ? strlen (b) : 0;
+    char *new = NULL;
+
+    if (!(new = SCE_Arena_Alloc (arena, la + lb + 1)))
+        SCEE_LogSrc ();
+    else {
+        if (a) memcpy (new, a, la);
+        if (b) memcpy (&new[la], b, lb);
+        new[la + lb] = '\0';
+    }
+    return new;
+}
+
+/**
+ * \brief Duplicates concatenated strings into an arena
+ * \param arena the arena to allocate from
+ * \param str the first string to be concatenated
+ * \param ... a NULL-ended list of strings to concatenate
+ * \sa SCE_String_CatDupMulti(), SCE_String_DupArena()
+ */
+char* SCE_String_CatDupMultiArena (SCE_SArena *arena, const char *str, ...)
+{
+    size_t size, len;
+    char *new, *p;
+    const char *tmp;
+    va_list ap;
+
+    size = strlen (str) + 1;
+    va_start (ap, str);
+    while ((tmp = va_arg (ap, const char*)) != NULL)
+        size += strlen (tmp);
+    va_end (ap);
+
+    if (!(new = SCE_Arena_Alloc (arena, size))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+
+    len = strlen (str);
+    memcpy (new, str, len);
+    p = &new[len];
+    va_start (ap, str);
+    while ((tmp = va_arg (ap, const char*)) != NULL) {
+        len = strlen (tmp);
+        memcpy (p, tmp, len);
+        p += len;
+    }
+    va_end (ap);
+    *p = '\0';
+
+    return new;
+}
+
 /**
  * \brief Replaces occurrences of a character by another
  * \param str a string
@@ -0,0 +1,264 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+#include <unistd.h>
+#include <pthread.h>
+#include "SCE/utils/SCEMacros.h"
+#include "SCE/utils/SCEError.h"
+#include "SCE/utils/SCEMemory.h"
+#include "SCE/utils/SCEThreadPool.h"
+
+/**
+ * \file SCEThreadPool.c
+ * \copydoc threadpool
+ * \brief Worker threads
+ *
+ * \file SCEThreadPool.h
+ * \copydoc threadpool
+ * \brief Worker threads
+ */
+
+/**
+ * \defgroup threadpool Worker threads
+ * \ingroup utils
+ *
+ * A thread pool runs tasks pushed by the caller on a fixed set of pthreads.
+ * Tasks are gathered in groups, SCE_ThreadPool_Wait() acts as a barrier
+ * for a group and makes the waiting thread run queued tasks too, so a pool
+ * without any thread still works, sequentially.
+ */
+
+/** @{ */
+
+static SCE_SThreadPool default_pool;
+static int default_started = SCE_FALSE;
+static pthread_mutex_t default_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * \internal
+ * \brief Initializes the default thread pool, its threads are only started
+ * at the first call to SCE_ThreadPool_GetDefault()
+ */
+int SCE_Init_ThreadPool (void)
+{
+    SCE_ThreadPool_Init (&default_pool);
+    default_started = SCE_FALSE;
+    return SCE_OK;
+}
+/**
+ * \internal
+ * \brief Stops the threads of the default thread pool
+ */
+void SCE_Quit_ThreadPool (void)
+{
+    SCE_ThreadPool_Clear (&default_pool);
+    default_started = SCE_FALSE;
+}
+
+
+/**
+ * \brief Initializes a thread pool, without any thread
+ * \sa SCE_ThreadPool_Start()
+ */
+void SCE_ThreadPool_Init (SCE_SThreadPool *pool)
+{
+    pool->threads = NULL;
+    pool->n_threads = 0;
+    SCE_List_Init (&pool->tasks);
+    pthread_mutex_init (&pool->mutex, NULL);
+    pthread_cond_init (&pool->work, NULL);
+    pthread_cond_init (&pool->done, NULL);
+    pool->quit = SCE_FALSE;
+}
+/**
+ * \brief Stops the threads of a thread pool
+ *
+ * The queued tasks are run before the threads exit.
+ */
+void SCE_ThreadPool_Clear (SCE_SThreadPool *pool)
+{
+    unsigned int i;
+
+    pthread_mutex_lock (&pool->mutex);
+    pool->quit = SCE_TRUE;
+    pthread_cond_broadcast (&pool->work);
+    pthread_mutex_unlock (&pool->mutex);
+    for (i = 0; i < pool->n_threads; i++)
+        pthread_join (pool->threads[i], NULL);
+    SCE_free (pool->threads);
+    pool->threads = NULL;
+    pool->n_threads = 0;
+
+    pthread_cond_destroy (&pool->done);
+    pthread_cond_destroy (&pool->work);
+    pthread_mutex_destroy (&pool->mutex);
+}
+
+/* runs a task, the mutex of the pool is locked */
+static void SCE_ThreadPool_Run (SCE_SThreadPool *pool, SCE_SThreadTask *task)
+{
+    pthread_mutex_unlock (&pool->mutex);
+    task->f (task->arg);
+    pthread_mutex_lock (&pool->mutex);
+    task->group->pending--;
+    if (!task->group->pending)
+        pthread_cond_broadcast (&pool->done);
+}
+
+static void* SCE_ThreadPool_Worker (void *arg)
+{
+    SCE_SThreadPool *pool = arg;
+    SCE_SListIterator *it = NULL;
+
+    pthread_mutex_lock (&pool->mutex);
+    for (;;) {
+        if (SCE_List_HasElements (&pool->tasks)) {
+            it = SCE_List_RemoveFirst (&pool->tasks);
+            SCE_ThreadPool_Run (pool, SCE_List_GetData (it));
+        } else if (pool->quit)
+            break;
+        else
+            pthread_cond_wait (&pool->work, &pool->mutex);
+    }
+    pthread_mutex_unlock (&pool->mutex);
+    return NULL;
+}
+
+/**
+ * \brief Starts the threads of a thread pool
+ * \param n number of threads to start
+ * \returns SCE_ERROR on error, SCE_OK otherwise
+ */
+int SCE_ThreadPool_Start (SCE_SThreadPool *pool, unsigned int n)
+{
+    unsigned int i;
+    int err;
+
+    if (!n)
+        return SCE_OK;
+    if (!(pool->threads = SCE_malloc (n * sizeof *pool->threads))) {
+        SCEE_LogSrc ();
+        return SCE_ERROR;
+    }
+    for (i = 0; i < n; i++) {
+        err = pthread_create (&pool->threads[i], NULL,
+                              SCE_ThreadPool_Worker, pool);
+        if (err) {
+            SCEE_LogFromErrno (err, "pthread_create()");
+            /* keep the threads already started */
+            break;
+        }
+    }
+    pool->n_threads = i;
+    return i == n ? SCE_OK : SCE_ERROR;
+}
+/**
+ * \brief Gets the number of threads of a thread pool
+ */
+unsigned int SCE_ThreadPool_GetNumThreads (const SCE_SThreadPool *pool)
+{
+    return pool->n_threads;
+}
+
+/**
+ * \brief Gets the thread pool shared by the library
+ *
+ * Its threads are started by the first call, one less than the number of
+ * processors since the waiting thread runs tasks too.
+ */
+SCE_SThreadPool* SCE_ThreadPool_GetDefault (void)
+{
+    long n;
+
+    pthread_mutex_lock (&default_mutex);
+    if (!default_started) {
+        default_started = SCE_TRUE;
+        n = sysconf (_SC_NPROCESSORS_ONLN);
+        if (n > 1 && SCE_ThreadPool_Start (&default_pool, n - 1) < 0) {
+            /* works with less threads, or none */
+            SCEE_Clear ();
+        }
+    }
+    pthread_mutex_unlock (&default_mutex);
+    return &default_pool;
+}
+
+
+/**
+ * \brief Initializes a group of tasks
+ */
+void SCE_ThreadPool_InitGroup (SCE_SThreadGroup *group)
+{
+    group->pending = 0;
+}
+/**
+ * \brief Initializes a task
+ * \param f function to run
+ * \param arg argument given to \p f
+ */
+void SCE_ThreadPool_InitTask (SCE_SThreadTask *task, SCE_FThreadTaskFunc f,
+                              void *arg)
+{
+    task->f = f;
+    task->arg = arg;
+    task->group = NULL;
+    SCE_List_InitIt (&task->it);
+    SCE_List_SetData (&task->it, task);
+}
+
+/**
+ * \brief Queues a task on a thread pool
+ * \param group group of the task
+ * \param task the task, must stay valid until \p group is waited for
+ * \sa SCE_ThreadPool_Wait()
+ */
+void SCE_ThreadPool_Push (SCE_SThreadPool *pool, SCE_SThreadGroup *group,
+                          SCE_SThreadTask *task)
+{
+    task->group = group;
+    pthread_mutex_lock (&pool->mutex);
+    group->pending++;
+    SCE_List_Appendl (&pool->tasks, &task->it);
+    pthread_cond_signal (&pool->work);
+    pthread_mutex_unlock (&pool->mutex);
+}
+
+/**
+ * \brief Waits until all the tasks of a group are done
+ *
+ * The calling thread runs queued tasks while it waits.
+ */
+void SCE_ThreadPool_Wait (SCE_SThreadPool *pool, SCE_SThreadGroup *group)
+{
+    SCE_SListIterator *it = NULL;
+
+    pthread_mutex_lock (&pool->mutex);
+    while (group->pending) {
+        if (SCE_List_HasElements (&pool->tasks)) {
+            it = SCE_List_RemoveFirst (&pool->tasks);
+            SCE_ThreadPool_Run (pool, SCE_List_GetData (it));
+        } else
+            pthread_cond_wait (&pool->done, &pool->mutex);
+    }
+    pthread_mutex_unlock (&pool->mutex);
+}
+
+/** @} */
@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 17/04/2010
-   updated: 23/01/2012 */
+   updated: 17/10/2026 */
 
 #include <string.h>
 #include "SCE/utils/SCEError.h"
@@ -171,3 +171,34 @@ void* SCE_Type_ConvertDup (int tdest, int tsrc, const void *src, size_t n)
     SCE_Type_Convert (tdest, dest, tsrc, src, n);
     return dest;
 }
+
+/**
+ * \brief Converts data into memory allocated from an arena
+ * \param arena the arena to allocate from
+ * \param tdest destination type
+ * \param tsrc source type
+ * \param src data to convert
+ * \param n number of variables into \p src
+ * \sa SCE_Type_ConvertDup(), SCE_Arena_Alloc()
+ */
+void* SCE_Type_ConvertDupArena (SCE_SArena *arena, int tdest, int tsrc,
+                                const void *src, size_t n)
+{
+    size_t size;
+    void *dest = NULL;
+
+    if (!(size = SCE_Type_Sizeof (tdest))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    if (n && size > (size_t)-1 / n) {
+        SCEE_Log (SCE_OUT_OF_MEMORY);
+        return NULL;
+    }
+    if (!(dest = SCE_Arena_Alloc (arena, size * n))) {
+        SCEE_LogSrc ();
+        return NULL;
+    }
+    SCE_Type_Convert (tdest, dest, tsrc, src, n);
+    return dest;
+}
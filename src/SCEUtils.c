@@ -66,12 +66,24 @@ int SCE_Init_Utils (FILE *outlog)
         } else if (SCE_Init_NullFS () < 0) {
             SCEE_LogSrc ();
             SCEE_LogSrcMsg ("can't initialize file manager");
+        } else if (SCE_Init_MmapFS () < 0) {
+            SCEE_LogSrc ();
+            SCEE_LogSrcMsg ("can't initialize mapped file manager");
+        } else if (SCE_Init_BufferedFS () < 0) {
+            SCEE_LogSrc ();
+            SCEE_LogSrcMsg ("can't initialize buffered file manager");
         } else if (SCE_Init_FileCache () < 0) {
             SCEE_LogSrc ();
             SCEE_LogSrcMsg ("can't initialize cache file manager");
         } else if (SCE_Init_Matrix () < 0) {
             SCEE_LogSrc ();
             SCEE_LogSrcMsg ("can't initialize matrices manager");
+        } else if (SCE_Init_ThreadPool () < 0) {
+            SCEE_LogSrc ();
+            SCEE_LogSrcMsg ("can't initialize thread pool");
+        } else if (SCE_Init_FileAsync () < 0) {
+            SCEE_LogSrc ();
+            SCEE_LogSrcMsg ("can't initialize asynchronous file manager");
         } else if (SCE_Init_FastList () < 0) {
             SCEE_LogSrc ();
             SCEE_LogSrcMsg ("can't initialize fast lists manager");
@@ -106,8 +118,12 @@ void SCE_Quit_Utils (void)
             SCE_Quit_Resource ();
             SCE_Quit_Media ();
             SCE_Quit_FastList ();
+            SCE_Quit_FileAsync ();
+            SCE_Quit_ThreadPool ();
             /*SCE_Quit_Matrix ();*/
             SCE_Quit_FileCache ();
+            SCE_Quit_BufferedFS ();
+            SCE_Quit_MmapFS ();
             SCE_Quit_NullFS ();
             SCE_Quit_File ();
             /*SCE_Quit_Error ();*/
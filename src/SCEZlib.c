@@ -17,7 +17,7 @@
  -----------------------------------------------------------------------------*/
 
 /* created: 13/08/2012
-   updated: 13/08/2012 */
+   updated: 17/10/2026 */
 
 #include "zlib.h"
 #include "SCE/utils/SCEError.h"
@@ -25,6 +25,7 @@
 #include "SCE/utils/SCEZlib.h"
 
 #define CHUNK_SIZE 16384
+#define MAX_CHUNK_SIZE (1u << 30)
 
 /* TODO: duplicated from SCEGZFile.c */
 static const char* xstrerr (int code)
@@ -40,12 +41,21 @@ static const char* xstrerr (int code)
     }
 }
 
+/* bytes to give to zlib for the next output step: what's left of the
+   storage of \p out, or a new chunk once it's full */
+static size_t xchunk (SCE_SArray *out)
+{
+    size_t left = SCE_Array_GetCapacity (out) - SCE_Array_GetSize (out);
+    if (!left)
+        return CHUNK_SIZE;
+    return left > MAX_CHUNK_SIZE ? MAX_CHUNK_SIZE : left;
+}
+
 
 int SCE_Zlib_Compress (void *data, size_t size, int level, SCE_SArray *out)
 {
     z_stream strm;
     int ret;
-    unsigned char buf[CHUNK_SIZE];
 
     strm.zalloc = Z_NULL;
     strm.zfree = Z_NULL;
@@ -60,10 +70,27 @@ int SCE_Zlib_Compress (void *data, size_t size, int level, SCE_SArray *out)
     strm.avail_in = size;
     strm.next_in = data;
 
+    /* the whole output fits, avoid growing the array chunk by chunk */
+    if (SCE_Array_Reserve (out, SCE_Array_GetSize (out) +
+                           deflateBound (&strm, size)) < 0) {
+        deflateEnd (&strm);
+        goto fail;
+    }
+
     do {
-        strm.avail_out = CHUNK_SIZE;
-        strm.next_out = buf;
+        size_t chunk = xchunk (out);
+        /* output directly into the array */
+        if (!(strm.next_out = SCE_Array_AppendUninit (out, chunk))) {
+            deflateEnd (&strm);
+            goto fail;
+        }
+        strm.avail_out = chunk;
         ret = deflate (&strm, Z_FINISH);
+        /* give back what wasn't written */
+        if (SCE_Array_PopBack (out, strm.avail_out) < 0) {
+            deflateEnd (&strm);
+            goto fail;
+        }
         if (ret == Z_STREAM_ERROR || ret == Z_MEM_ERROR ||
             ret == Z_DATA_ERROR || ret == Z_NEED_DICT) {
             deflateEnd (&strm);
@@ -71,10 +98,6 @@ int SCE_Zlib_Compress (void *data, size_t size, int level, SCE_SArray *out)
             SCEE_LogMsg ("zlib deflate() error: %s", xstrerr (ret));
             goto fail;
         }
-        if (SCE_Array_Append (out, buf, CHUNK_SIZE - strm.avail_out) < 0) {
-            deflateEnd (&strm);
-            goto fail;
-        }
     } while (strm.avail_out == 0);
 
     deflateEnd (&strm);
@@ -89,7 +112,6 @@ int SCE_Zlib_Decompress (void *data, size_t size, SCE_SArray *out)
 {
     z_stream strm;
     int ret;
-    unsigned char buf[CHUNK_SIZE];
 
     strm.zalloc = Z_NULL;
     strm.zfree = Z_NULL;
@@ -106,10 +128,27 @@ int SCE_Zlib_Decompress (void *data, size_t size, SCE_SArray *out)
     strm.avail_in = size;
     strm.next_in = data;
 
+    /* the output size is unknown, start with a guess of a 1:2 ratio and let
+       the array grow geometrically past it */
+    if (SCE_Array_Reserve (out, SCE_Array_GetSize (out) + 2 * size) < 0) {
+        inflateEnd (&strm);
+        goto fail;
+    }
+
     do {
-        strm.avail_out = CHUNK_SIZE;
-        strm.next_out = buf;
+        size_t chunk = xchunk (out);
+        /* output directly into the array */
+        if (!(strm.next_out = SCE_Array_AppendUninit (out, chunk))) {
+            inflateEnd (&strm);
+            goto fail;
+        }
+        strm.avail_out = chunk;
         ret = inflate (&strm, Z_NO_FLUSH);
+        /* give back what wasn't written */
+        if (SCE_Array_PopBack (out, strm.avail_out) < 0) {
+            inflateEnd (&strm);
+            goto fail;
+        }
         if (ret == Z_STREAM_ERROR || ret == Z_MEM_ERROR ||
             ret == Z_DATA_ERROR || ret == Z_NEED_DICT) {
             inflateEnd (&strm);
@@ -117,10 +156,6 @@ int SCE_Zlib_Decompress (void *data, size_t size, SCE_SArray *out)
             SCEE_LogMsg ("zlib inflate() error: %s", xstrerr (ret));
             goto fail;
         }
-        if (SCE_Array_Append (out, buf, CHUNK_SIZE - strm.avail_out) < 0) {
-            inflateEnd (&strm);
-            goto fail;
-        }
     } while (strm.avail_out == 0);
 
     inflateEnd (&strm);
@@ -0,0 +1,184 @@
+/*------------------------------------------------------------------------------
+    SCEngine - A 3D real time rendering engine written in the C language
+    Copyright (C) 2006-2013  Antony Martin <martin(dot)antony(at)yahoo(dot)fr>
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/* created: 17/10/2026
+   updated: 17/10/2026 */
+
+/* stress test of SCE_SAtomicList: several producers push numbered nodes
+   while the consumer alternates SCE_AtomicList_Pop() and
+   SCE_AtomicList_PopAll(). Every node must come out once, and the nodes of
+   a producer in the order it pushed them.
+
+   usage: atomiclist [producers] [nodes per producer] */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <SCE/utils/SCEUtils.h>
+
+typedef struct {
+    SCE_SListIterator it;
+    int producer;
+    unsigned long seq;
+} node;
+
+typedef struct {
+    SCE_SAtomicList *q;
+    node *nodes;
+    unsigned long n_nodes;
+} producer_args;
+
+static void* produce (void *data)
+{
+    const producer_args *args = data;
+    unsigned long i;
+
+    for (i = 0; i < args->n_nodes; i++) {
+        SCE_AtomicList_Push (args->q, &args->nodes[i].it);
+        /* let the consumer catch up from time to time, so that the list
+           goes through empty and short states too */
+        if (i % 1024 == 0)
+            sched_yield ();
+    }
+    return NULL;
+}
+
+/* checks a popped node, returns 0 if it is out of order */
+static int consume (SCE_SListIterator *it, unsigned long *expected)
+{
+    node *n = SCE_List_GetData (it);
+
+    if (n->seq != expected[n->producer]) {
+        fprintf (stderr, "atomiclist: producer %d: got node %lu, expected "
+                 "%lu\n", n->producer, n->seq, expected[n->producer]);
+        return 0;
+    }
+    expected[n->producer]++;
+    return 1;
+}
+
+int main (int argc, char **argv)
+{
+    int n_producers = 4, i;
+    unsigned long n_nodes = 200000, j, received = 0, total, round = 0;
+    SCE_SAtomicList q;
+    pthread_t *threads = NULL;
+    producer_args *args = NULL;
+    unsigned long *expected = NULL;
+
+    if (argc > 1)
+        n_producers = atoi (argv[1]);
+    if (argc > 2)
+        n_nodes = strtoul (argv[2], NULL, 10);
+    if (n_producers < 1) {
+        fprintf (stderr, "usage: %s [producers] [nodes per producer]\n",
+                 argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    threads = malloc (n_producers * sizeof *threads);
+    args = malloc (n_producers * sizeof *args);
+    expected = calloc (n_producers, sizeof *expected);
+    if (!threads || !args || !expected) {
+        perror ("malloc");
+        return EXIT_FAILURE;
+    }
+
+    /* a lost link can make the consumer loop forever, fail instead */
+    alarm (120);
+
+    SCE_AtomicList_Init (&q);
+    for (i = 0; i < n_producers; i++) {
+        args[i].q = &q;
+        args[i].n_nodes = n_nodes;
+        if (!(args[i].nodes = malloc (n_nodes * sizeof (node)))) {
+            perror ("malloc");
+            return EXIT_FAILURE;
+        }
+        for (j = 0; j < n_nodes; j++) {
+            node *n = &args[i].nodes[j];
+            SCE_List_InitIt (&n->it);
+            SCE_List_SetData (&n->it, n);
+            n->producer = i;
+            n->seq = j;
+        }
+    }
+    for (i = 0; i < n_producers; i++) {
+        if (pthread_create (&threads[i], NULL, produce, &args[i])) {
+            fprintf (stderr, "atomiclist: failed to create a thread\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    total = n_nodes * n_producers;
+    while (received < total) {
+        unsigned long got = 0;
+
+        if (round++ % 2) {
+            SCE_SListIterator *it = NULL;
+            while (got < 64 && (it = SCE_AtomicList_Pop (&q))) {
+                if (!consume (it, expected))
+                    return EXIT_FAILURE;
+                got++;
+            }
+        } else {
+            SCE_SList l;
+            SCE_SListIterator *it = NULL, *pro = NULL;
+
+            SCE_List_Init (&l);
+            SCE_List_CanDeleteIterators (&l, SCE_FALSE);
+            got = SCE_AtomicList_PopAll (&q, &l);
+            if (got != SCE_List_GetLength (&l)) {
+                fprintf (stderr, "atomiclist: PopAll() returned %lu but "
+                         "moved %u nodes\n", got, SCE_List_GetLength (&l));
+                return EXIT_FAILURE;
+            }
+            SCE_List_ForEachProtected (pro, it, &l) {
+                SCE_List_Removel (it);
+                if (!consume (it, expected))
+                    return EXIT_FAILURE;
+            }
+        }
+        received += got;
+        if (!got)
+            sched_yield ();
+    }
+
+    for (i = 0; i < n_producers; i++)
+        pthread_join (threads[i], NULL);
+
+    if (!SCE_AtomicList_IsEmpty (&q) || SCE_AtomicList_Pop (&q)) {
+        fprintf (stderr, "atomiclist: nodes left after all were received\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < n_producers; i++) {
+        if (expected[i] != n_nodes) {
+            fprintf (stderr, "atomiclist: producer %d: %lu nodes received "
+                     "out of %lu\n", i, expected[i], n_nodes);
+            return EXIT_FAILURE;
+        }
+        free (args[i].nodes);
+    }
+    free (expected);
+    free (args);
+    free (threads);
+
+    return EXIT_SUCCESS;
+}